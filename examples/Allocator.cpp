@@ -1,5 +1,7 @@
 #include "main/Main.hpp"
 
+#include <nova/core/Arena.hpp>
+#include <nova/core/SlotMap.hpp>
 #include <nova/core/win32/Win32.hpp>
 
 NOVA_EXAMPLE(AllocTest, "alloc")
@@ -88,4 +90,85 @@ NOVA_EXAMPLE(AllocTest, "alloc")
     nova::Log("{} alloc/s", wall_allocs_per_second);
     nova::Log("per thread wall time: ({}) / ({} total)", TimeStr(cpu_seconds / total_allocs), TimeStr(cpu_seconds));
     nova::Log("per thread user time: ({}) / ({} total)", TimeStr(user_seconds / total_allocs), TimeStr(user_seconds));
-}
\ No newline at end of file
+}
+NOVA_EXAMPLE(ArenaTest, "arena")
+{
+    using namespace std::chrono;
+
+    constexpr u32 Frames = 1000;
+    constexpr u32 Items  = 10'000;
+
+    // Builds a typical per-frame working set: a vector, temporary strings and a lookup map
+    auto Frame = [](auto& items, auto& lookup, auto make_string) {
+        for (u32 i = 0; i < Items; ++i) {
+            items.push_back(i);
+            auto name = make_string();
+            name += "frame_item_";
+            name += std::to_string(i);
+            lookup[i] = name.size();
+        }
+    };
+
+    duration<f64> heap_time{ MeasureSeconds(Frames, [&] {
+        std::vector<u32> items;
+        nova::HashMap<u32, usz> lookup;
+        Frame(items, lookup, [] { return std::string{}; });
+    }) };
+
+    nova::Arena arena;
+    duration<f64> arena_time{ MeasureSeconds(Frames, [&] {
+        {
+            nova::ArenaVector<u32> items{arena};
+            nova::ArenaHashMap<u32, usz> lookup{arena};
+            Frame(items, lookup, [&] { return nova::ArenaString{arena}; });
+        }
+        arena.Reset();
+    }) };
+
+    nova::Log("heap:  {} / frame", nova::DurationToString(heap_time));
+    nova::Log("arena: {} / frame ({} committed)", nova::DurationToString(arena_time), nova::ByteSizeToString(arena.GetCommitted()));
+}
+
+NOVA_EXAMPLE(FreeListTest, "freelist")
+{
+    using namespace std::chrono;
+
+    // Mirrors descriptor churn from loader threads: each thread repeatedly acquires a batch of indices and releases
+    // them again, until 1M descriptors have been created and destroyed in total
+
+    constexpr u32 Threads = 16;
+    constexpr u32 Batch   = 64;
+    constexpr u32 Rounds  = (1'000'000 + Threads * Batch - 1) / (Threads * Batch);
+    constexpr u32 Ops     = 2 * Rounds * Threads * Batch;
+
+    auto Run = [&](auto&& acquire, auto&& release) {
+        std::vector<std::jthread> threads;
+        auto start = steady_clock::now();
+        for (u32 t = 0; t < Threads; ++t) {
+            threads.emplace_back([&] {
+                std::array<nova::SlotKey, Batch> keys;
+                for (u32 i = 0; i < Rounds; ++i) {
+                    for (auto& key : keys) key = acquire();
+                    for (auto& key : keys) release(key);
+                }
+            });
+        }
+        threads.clear();
+        return steady_clock::now() - start;
+    };
+
+    nova::IndexFreeList locked_list;
+    std::shared_mutex mutex;
+    auto locked_time = Run(
+        [&] { std::scoped_lock lock{ mutex }; return nova::SlotKey{ locked_list.Acquire(), 1 }; },
+        [&](nova::SlotKey key) { std::scoped_lock lock{ mutex }; locked_list.Release(key.index); });
+
+    nova::ConcurrentIndexFreeList concurrent_list{ Threads * Batch };
+    auto concurrent_time = Run(
+        [&] { return concurrent_list.Acquire(); },
+        [&](nova::SlotKey key) { concurrent_list.Release(key); });
+
+    nova::Log("mutex:     {} ({} / op)", nova::DurationToString(locked_time), nova::DurationToString(locked_time / Ops));
+    nova::Log("lock-free: {} ({} / op, {} indices used)", nova::DurationToString(concurrent_time),
+        nova::DurationToString(concurrent_time / Ops), concurrent_list.HighWaterMark());
+}
@@ -0,0 +1,70 @@
+#include "main/Main.hpp"
+
+#include <nova/core/Base64.hpp>
+
+// -----------------------------------------------------------------------------
+//                             Base64 benchmark
+// -----------------------------------------------------------------------------
+
+// Compares the scalar fallback against the vectorized codec on a large random blob, and checks that streaming in
+// small chunks produces the same output as a one-shot encode
+
+NOVA_EXAMPLE(Base64Bench, "base64")
+{
+    constexpr usz Size   = 64ull * 1024 * 1024;
+    constexpr usz Chunk  = 64ull * 1024;
+    constexpr u32 Rounds = 8;
+
+    std::vector<b8> data(Size);
+    {
+        std::mt19937_64 rng{ 1 };
+        for (usz i = 0; i < Size; i += 8) {
+            u64 v = rng();
+            std::memcpy(data.data() + i, &v, std::min(usz(8), Size - i));
+        }
+    }
+
+    std::string encoded(nova::base64::EncodedSize(Size), '\0');
+    std::vector<b8> decoded(Size);
+
+    // GB/s
+    auto Measure = [&](auto&& fn) {
+        return f64(Size) / MeasureSeconds(Rounds, fn) / 1e9;
+    };
+
+    f64 scalar_encode = Measure([&] {
+        nova::base64::detail::EncodeScalar(encoded.data(), reinterpret_cast<const u8*>(data.data()), Size, true, nova::base64::tables::Default);
+    });
+    f64 scalar_decode = Measure([&] {
+        nova::base64::detail::DecodeScalar(reinterpret_cast<u8*>(decoded.data()), encoded.data(), encoded.size(), nova::base64::tables::Default);
+    });
+
+    f64 simd_encode = Measure([&] {
+        nova::base64::Encode(encoded.data(), encoded.size(), data.data(), Size);
+    });
+    f64 simd_decode = Measure([&] {
+        nova::base64::Decode(decoded.data(), decoded.size(), encoded.data(), encoded.size());
+    });
+
+    std::string streamed;
+    streamed.reserve(encoded.size());
+    f64 stream_encode = Measure([&] {
+        streamed.clear();
+        nova::base64::Encoder encoder;
+        for (usz offset = 0; offset < Size; offset += Chunk) {
+            encoder.Update(streamed, nova::Span<b8>(data.data() + offset, std::min(Chunk, Size - offset)));
+        }
+        encoder.Finish(streamed);
+    });
+
+    if (streamed != encoded || decoded != data) {
+        NOVA_THROW("Base64 round trip mismatch");
+    }
+
+    nova::Log("implementation: {}", simdutf::get_active_implementation()->name());
+    nova::Log("scalar encode: {:.2f} GB/s", scalar_encode);
+    nova::Log("scalar decode: {:.2f} GB/s", scalar_decode);
+    nova::Log("simd   encode: {:.2f} GB/s", simd_encode);
+    nova::Log("simd   decode: {:.2f} GB/s", simd_decode);
+    nova::Log("stream encode: {:.2f} GB/s ({} chunks)", stream_encode, nova::ByteSizeToString(Chunk));
+}
@@ -0,0 +1,371 @@
+#include "main/Main.hpp"
+
+#include <nova/core/JobSystem.hpp>
+
+namespace
+{
+    // Per job heap allocations of the baseline, the counterpart of JobSystem::GetHeapAllocationCount. Queue storage
+    // is amortized and not counted on either side
+
+    std::atomic<u64> LockedAllocationCount = 0;
+
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+        T* allocate(usz count)
+        {
+            LockedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            return std::allocator<T>{}.allocate(count);
+        }
+
+        void deallocate(T* ptr, usz count) noexcept
+        {
+            std::allocator<T>{}.deallocate(ptr, count);
+        }
+
+        bool operator==(const CountingAllocator&) const noexcept = default;
+    };
+
+// -----------------------------------------------------------------------------
+
+    // Previous single queue implementation, kept as a baseline for comparison
+
+    struct LockedJobSystem;
+
+    struct LockedJob : nova::RefCounted
+    {
+        LockedJobSystem*                                                                 system = {};
+        std::function<void()>                                                              task;
+        std::vector<nova::Ref<nova::Barrier>, CountingAllocator<nova::Ref<nova::Barrier>>> signals;
+
+        static void* operator new(usz size)
+        {
+            LockedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        static void operator delete(void* ptr)
+        {
+            ::operator delete(ptr);
+        }
+    };
+
+    struct LockedJobSystem
+    {
+        std::vector<std::jthread>        workers;
+        std::deque<nova::Ref<LockedJob>>   queue;
+        std::shared_mutex                  mutex;
+        std::condition_variable_any           cv;
+
+        bool running = true;
+
+        LockedJobSystem(u32 threads)
+        {
+            for (u32 i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { Worker(); });
+            }
+        }
+
+        ~LockedJobSystem()
+        {
+            {
+                std::scoped_lock lock{mutex};
+                running = false;
+                cv.notify_all();
+            }
+            workers.clear();
+        }
+
+        void Worker()
+        {
+            for (;;) {
+                std::unique_lock lock{mutex};
+                while (queue.empty()) {
+                    if (!running) {
+                        return;
+                    }
+                    cv.wait(lock);
+                }
+                auto job = queue.front();
+                queue.pop_front();
+                lock.unlock();
+
+                job->task();
+
+                for (auto& signal : job->signals) {
+                    if (--signal->counter == 0) {
+                        signal->counter.notify_all();
+                    }
+                }
+            }
+        }
+
+        void Submit(std::function<void()> task, nova::Ref<nova::Barrier> signal)
+        {
+            nova::Ref job = new LockedJob();
+            job->system = this;
+            job->task = std::move(task);
+            signal->counter++;
+            job->signals.emplace_back(std::move(signal));
+
+            std::scoped_lock lock{mutex};
+            queue.push_back(std::move(job));
+            cv.notify_one();
+        }
+    };
+
+    // Work is kept deliberately tiny so that scheduling overhead dominates
+
+    NOVA_NO_INLINE
+    void SpinWork(std::atomic<u64>& sink, u64 value)
+    {
+        sink.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+NOVA_EXAMPLE(JobSystemBench, "jobs")
+{
+    using namespace std::chrono;
+
+    u32 job_count = 1'000'000;
+    if (!args.empty()) {
+        std::from_chars(args[0].Data(), args[0].Data() + args[0].Size(), job_count);
+    }
+
+    auto JobsPerSecond = [&](auto start, auto end) {
+        return f64(job_count) / duration_cast<duration<f64>>(end - start).count();
+    };
+
+    auto AllocationsPerJob = [&](u64 start, u64 end) {
+        return f64(end - start) / f64(job_count);
+    };
+
+    nova::Log("{:>8} | {:>16} | {:>16} | {:>16} | {:>13} | {:>13}",
+        "threads", "locked (flat)", "stealing (flat)", "stealing (fork)", "locked a/job", "stealing a/job");
+
+    for (u32 thread_count : { 1, 4, 16, 64 }) {
+        std::atomic<u64> sink = 0;
+
+        // Baseline: every job submitted from the main thread through a single locked queue
+
+        f64 locked_flat;
+        f64 locked_allocs;
+        {
+            LockedJobSystem locked{thread_count};
+            auto barrier = nova::Barrier::Create();
+            auto start = steady_clock::now();
+            u64 allocs_start = LockedAllocationCount.load();
+            for (u32 i = 0; i < job_count; ++i) {
+                locked.Submit([&sink, i] { SpinWork(sink, i); }, barrier);
+            }
+            barrier->Wait();
+            locked_flat = JobsPerSecond(start, steady_clock::now());
+            locked_allocs = AllocationsPerJob(allocs_start, LockedAllocationCount.load());
+        }
+
+        nova::JobSystem jobs{thread_count};
+
+        // Same pattern on the work stealing scheduler, all jobs arrive through the injection queue
+
+        f64 stealing_flat;
+        f64 stealing_allocs;
+        {
+            auto barrier = nova::Barrier::Create();
+            auto start = steady_clock::now();
+            u64 allocs_start = nova::JobSystem::GetHeapAllocationCount();
+            for (u32 i = 0; i < job_count; ++i) {
+                nova::Job::Create(&jobs, [&sink, i] { SpinWork(sink, i); })->Signal(barrier)->Submit();
+            }
+            barrier->Wait();
+            stealing_flat = JobsPerSecond(start, steady_clock::now());
+            stealing_allocs = AllocationsPerJob(allocs_start, nova::JobSystem::GetHeapAllocationCount());
+        }
+
+        // Recursive fork from inside workers, exercises the local deques and stealing (rate counts leaf jobs)
+
+        f64 stealing_fork;
+        {
+            auto barrier = nova::Barrier::Create();
+            std::function<void(u32, u32)> fork = [&](u32 first, u32 last) {
+                nova::Job::Create(&jobs, [&, first, last] {
+                    if (last - first == 1) {
+                        SpinWork(sink, first);
+                        return;
+                    }
+                    u32 middle = first + (last - first) / 2;
+                    fork(first, middle);
+                    fork(middle, last);
+                })->Signal(barrier)->Submit();
+            };
+
+            auto start = steady_clock::now();
+            fork(0, job_count);
+            barrier->Wait();
+            stealing_fork = JobsPerSecond(start, steady_clock::now());
+        }
+
+        nova::Log("{:>8} | {:>12.0f} j/s | {:>12.0f} j/s | {:>12.0f} j/s | {:>13.3f} | {:>13.3f}",
+            thread_count, locked_flat, stealing_flat, stealing_fork, locked_allocs, stealing_allocs);
+    }
+}
+
+NOVA_EXAMPLE(JobSystemStress, "jobstress")
+{
+    using namespace std::chrono;
+
+    u32 iterations = 100;
+    if (!args.empty()) {
+        std::from_chars(args[0].Data(), args[0].Data() + args[0].Size(), iterations);
+    }
+
+    // Every job waits on a barrier for its children, so with a blocking wait the pool deadlocks as soon as
+    // the nesting depth exceeds the worker count. Waiting workers must execute other jobs to make progress.
+
+    for (u32 thread_count : { 1, 2, 4, 16 }) {
+        nova::JobSystem jobs{thread_count};
+
+        auto Run = [&](auto&& root) {
+            auto barrier = nova::Barrier::Create();
+            nova::Job::Create(&jobs, root)->Signal(barrier)->Submit();
+            barrier->Wait();
+        };
+
+        auto start = steady_clock::now();
+
+        for (u32 i = 0; i < iterations; ++i) {
+
+            // Linear chain, one outstanding barrier per level
+
+            constexpr u32 ChainDepth = 256;
+            std::atomic<u32> chain_leaves = 0;
+            std::function<void(u32)> chain = [&](u32 depth) {
+                if (depth == ChainDepth) {
+                    chain_leaves++;
+                    return;
+                }
+                auto barrier = nova::Barrier::Create();
+                nova::Job::Create(&jobs, [&, depth] { chain(depth + 1); })->Signal(barrier)->Submit();
+                barrier->Wait();
+            };
+            Run([&] { chain(0); });
+
+            // Binary fork/join tree, barriers nest at every level and are stolen across workers
+
+            constexpr u32 TreeDepth = 12;
+            std::atomic<u32> tree_leaves = 0;
+            std::function<void(u32)> tree = [&](u32 depth) {
+                if (depth == TreeDepth) {
+                    tree_leaves++;
+                    return;
+                }
+                auto barrier = nova::Barrier::Create();
+                nova::Job::Create(&jobs, [&, depth] { tree(depth + 1); })->Signal(barrier)->Submit();
+                nova::Job::Create(&jobs, [&, depth] { tree(depth + 1); })->Signal(barrier)->Submit();
+                barrier->Wait();
+            };
+            Run([&] { tree(0); });
+
+            // Barrier continuations submitted from inside nested waits
+
+            constexpr u32 StagedDepth = 64;
+            std::atomic<u32> continuations = 0;
+            std::function<void(u32)> staged = [&](u32 depth) {
+                if (depth == StagedDepth) {
+                    return;
+                }
+                auto barrier = nova::Barrier::Create();
+                auto done = nova::Barrier::Create();
+                barrier->Add(nova::Job::Create(&jobs, [&, depth] {
+                    continuations++;
+                    staged(depth + 1);
+                })->Signal(done));
+                nova::Job::Create(&jobs, [] {})->Signal(barrier)->Submit();
+                done->Wait();
+            };
+            Run([&] { staged(0); });
+
+            if (chain_leaves != 1 || tree_leaves != (1u << TreeDepth) || continuations != StagedDepth) {
+                NOVA_THROW("JobSystem stress failed: chain = {}, tree = {}, continuations = {}",
+                    chain_leaves.load(), tree_leaves.load(), continuations.load());
+            }
+        }
+
+        nova::Log("{:>8} threads | {} iterations in {}", thread_count, iterations,
+            nova::DurationToString(steady_clock::now() - start));
+    }
+
+    // Blocking I/O jobs must not delay compute jobs, and critical jobs must overtake queued background work
+
+    {
+        nova::JobSystem jobs{1, 2};
+
+        auto io_done = nova::Barrier::Create();
+        for (u32 i = 0; i < 8; ++i) {
+            nova::Job::Create(&jobs, [] { std::this_thread::sleep_for(20ms); })->IO()->Signal(io_done)->Submit();
+        }
+
+        std::atomic<u32> order = 0;
+        std::atomic<u32> critical_position = 0;
+        auto compute_done = nova::Barrier::Create();
+        auto start = steady_clock::now();
+        {
+            // Hold the only compute worker so that all submissions below are queued before any run
+            std::atomic<bool> release = false;
+            nova::Job::Create(&jobs, [&] { while (!release) std::this_thread::yield(); })->Signal(compute_done)->Submit();
+            for (u32 i = 0; i < 100; ++i) {
+                nova::Job::Create(&jobs, [&] { order++; })->Priority(nova::JobPriority::Background)->Signal(compute_done)->Submit();
+            }
+            nova::Job::Create(&jobs, [&] { critical_position = order++; })->Priority(nova::JobPriority::Critical)->Signal(compute_done)->Submit();
+
+            auto stats = jobs.GetStats();
+            nova::Log("queued: critical = {}, normal = {}, background = {}, io = {}",
+                stats.queued[0], stats.queued[1], stats.queued[2], stats.io_queued[0] + stats.io_queued[1] + stats.io_queued[2]);
+
+            release = true;
+        }
+        compute_done->Wait();
+        auto compute_time = steady_clock::now() - start;
+        io_done->Wait();
+
+        if (critical_position != 0) {
+            NOVA_THROW("Critical job ran at position {}", critical_position.load());
+        }
+
+        nova::Log("compute finished in {} while blocking I/O took {}",
+            nova::DurationToString(compute_time), nova::DurationToString(steady_clock::now() - start));
+    }
+
+    // Optionally record a traced fork/join run and export it for chrome://tracing or Perfetto
+
+    if (args.size() > 1) {
+        nova::JobSystem jobs{4, 1};
+        nova::JobTrace::Enable();
+
+        std::function<void(u32)> tree = [&](u32 depth) {
+            if (depth == 10) {
+                return;
+            }
+            auto barrier = nova::Barrier::Create();
+            nova::Job::Create(&jobs, [&, depth] { tree(depth + 1); })->Name("Left")->Signal(barrier)->Submit();
+            nova::Job::Create(&jobs, [&, depth] { tree(depth + 1); })->Name("Right")->Signal(barrier)->Submit();
+            barrier->Wait();
+        };
+        auto barrier = nova::Barrier::Create();
+        nova::Job::Create(&jobs, [&] { tree(0); })->Name("Root")->Signal(barrier)->Submit();
+        nova::Job::Create(&jobs, [] { std::this_thread::sleep_for(1ms); })->Name("Read")->IO()->Signal(barrier)->Submit();
+        barrier->Wait();
+
+        nova::JobTrace::Enable(false);
+
+        std::ofstream out{std::string(args[1].Data(), args[1].Size())};
+        nova::JobTrace::WriteChromeTrace(out);
+        nova::Log("Trace written to {}", args[1]);
+    }
+}
@@ -0,0 +1,192 @@
+#include "main/Main.hpp"
+
+#include <nova/core/JsonBinding.hpp>
+#include <nova/core/JsonStream.hpp>
+
+// -----------------------------------------------------------------------------
+//                           JSON binding benchmark
+// -----------------------------------------------------------------------------
+
+// Compares deserializing a large generated manifest with one operator[] lookup per field against the single pass
+// struct binding, and checks that writing the bound records back out reproduces the input
+
+namespace
+{
+    struct ManifestEntry
+    {
+        std::string                          name;
+        std::string                          path;
+        std::optional<std::string>           hash;
+        u64                                  size = 0;
+        u64                              modified = 0;
+        f64                                 score = 0;
+        bool                             is_public = false;
+        std::vector<std::string>             tags;
+        std::vector<std::string>          depends;
+        std::optional<std::string>          owner;
+        std::optional<std::string>        license;
+        std::optional<std::string>    description;
+    };
+
+    struct Manifest
+    {
+        std::vector<ManifestEntry> entries;
+    };
+}
+
+NOVA_JSON_BIND(ManifestEntry,
+    NOVA_JSON_FIELD("name",        name),
+    NOVA_JSON_FIELD("path",        path),
+    NOVA_JSON_FIELD("hash",        hash),
+    NOVA_JSON_FIELD("size",        size),
+    NOVA_JSON_FIELD("modified",    modified),
+    NOVA_JSON_FIELD("score",       score),
+    NOVA_JSON_FIELD("public",      is_public),
+    NOVA_JSON_FIELD("tags",        tags),
+    NOVA_JSON_FIELD("depends",     depends),
+    NOVA_JSON_FIELD("owner",       owner),
+    NOVA_JSON_FIELD("license",     license),
+    NOVA_JSON_FIELD("description", description));
+
+NOVA_JSON_BIND(Manifest,
+    NOVA_JSON_FIELD("entries", entries));
+
+NOVA_EXAMPLE(JsonBindBench, "json-bind")
+{
+    constexpr u32 Count  = 100'000;
+    constexpr u32 Rounds = 4;
+
+    Manifest manifest;
+    {
+        std::mt19937_64 rng{ 1 };
+        for (u32 i = 0; i < Count; ++i) {
+            auto& entry = manifest.entries.emplace_back();
+            entry.name = nova::Fmt("entry-{}", i);
+            entry.path = nova::Fmt("data/assets/group-{}/entry-{}.bin", i % 97, i);
+            if (i % 3) entry.hash = nova::Fmt("{:016x}", rng());
+            entry.size = rng() % (1 << 24);
+            entry.modified = rng() % 2'000'000'000;
+            entry.score = f64(rng() % 10'000) / 100.0;
+            entry.is_public = i & 1;
+            for (u32 t = 0; t < i % 4; ++t) entry.tags.emplace_back(nova::Fmt("tag-{}", rng() % 32));
+            for (u32 d = 0; d < i % 3; ++d) entry.depends.emplace_back(nova::Fmt("entry-{}", rng() % Count));
+            if (i % 5 == 0) entry.owner = "team";
+            if (i % 7 == 0) entry.license = "MIT";
+            if (i % 11 == 0) entry.description = "Generated \"manifest\" entry\twith escapes";
+        }
+    }
+
+    std::string json;
+    {
+        nova::JsonWriter writer(json, true);
+        nova::JsonWrite(writer, manifest);
+    }
+
+    JsonDocument doc(json);
+
+    // Milliseconds per round
+    auto Measure = [&](auto&& fn) {
+        return MeasureSeconds(Rounds, fn) * 1e3;
+    };
+
+    auto ReadStrings = [](JsonValue value) {
+        std::vector<std::string> out;
+        for (auto element : value) out.emplace_back(element.string());
+        return out;
+    };
+
+    auto OptionalString = [](JsonValue value) -> std::optional<std::string> {
+        if (auto str = value.string()) return str;
+        return std::nullopt;
+    };
+
+    Manifest by_lookup;
+    f64 lookup_ms = Measure([&] {
+        by_lookup.entries.clear();
+        for (auto in_entry : doc.root()["entries"]) {
+            auto& entry = by_lookup.entries.emplace_back();
+            entry.name        = in_entry["name"].string();
+            entry.path        = in_entry["path"].string();
+            entry.hash        = OptionalString(in_entry["hash"]);
+            entry.size        = in_entry["size"].uint64().value_or(0);
+            entry.modified    = in_entry["modified"].uint64().value_or(0);
+            entry.score       = in_entry["score"].real().value_or(f64(in_entry["score"].uint64().value_or(0)));
+            entry.is_public   = in_entry["public"].boolean().value_or(false);
+            entry.tags        = ReadStrings(in_entry["tags"]);
+            entry.depends     = ReadStrings(in_entry["depends"]);
+            entry.owner       = OptionalString(in_entry["owner"]);
+            entry.license     = OptionalString(in_entry["license"]);
+            entry.description = OptionalString(in_entry["description"]);
+        }
+    });
+
+    Manifest by_binding;
+    f64 binding_ms = Measure([&] {
+        by_binding = nova::JsonRead<Manifest>(doc.root());
+    });
+
+    std::string round_trip;
+    {
+        nova::JsonWriter writer(round_trip, true);
+        nova::JsonWrite(writer, by_binding);
+    }
+
+    if (round_trip != json || by_lookup.entries.size() != Count) {
+        NOVA_THROW("JSON binding round trip mismatch");
+    }
+
+    nova::Log("manifest: {} entries, {}", Count, nova::ByteSizeToString(json.size()));
+    nova::Log("operator[] lookups: {:.2f} ms", lookup_ms);
+    nova::Log("struct binding:     {:.2f} ms ({:.2f}x)", binding_ms, lookup_ms / binding_ms);
+}
+
+// -----------------------------------------------------------------------------
+//                           JSON stream benchmark
+// -----------------------------------------------------------------------------
+
+// Splits a generated NDJSON log into records and parses them serially and across the job system
+
+NOVA_EXAMPLE(JsonStreamBench, "json-stream")
+{
+    constexpr u32 Count = 1'000'000;
+
+    std::string ndjson;
+    {
+        constexpr const char* Args[] = { "", "0", "0,1", "0,1,2", "0,1,2,3" };
+        auto out = std::back_inserter(ndjson);
+        for (u32 i = 0; i < Count; ++i) {
+            fmt::format_to(out, R"({{"id":{},"name":"event-{}","ts":{},"args":[{}]}})" "\n", i, i % 1000, u64(i) * 1000, Args[i % 5]);
+        }
+    }
+
+    // GB/s, fn returns the sum of the record ids
+    auto Measure = [&](auto&& fn) {
+        return f64(ndjson.size()) / MeasureSeconds(1, [&] {
+            if (fn() != u64(Count) * (Count - 1) / 2) {
+                NOVA_THROW("JSON stream checksum mismatch");
+            }
+        }) / 1e9;
+    };
+
+    f64 serial = Measure([&] {
+        u64 sum = 0;
+        nova::JsonStreamReader reader(ndjson);
+        reader.ForEach([&](JsonValue record) {
+            sum += record["id"].uint64().value_or(0);
+        });
+        return sum;
+    });
+
+    f64 parallel = Measure([&] {
+        std::atomic<u64> sum = 0;
+        nova::JsonStreamReader reader(ndjson);
+        reader.ParallelForEach([&](JsonValue record) {
+            sum.fetch_add(record["id"].uint64().value_or(0), std::memory_order::relaxed);
+        });
+        return sum.load();
+    });
+
+    nova::Log("ndjson: {} records, {}", Count, nova::ByteSizeToString(ndjson.size()));
+    nova::Log("serial:   {:.2f} GB/s", serial);
+    nova::Log("parallel: {:.2f} GB/s", parallel);
+}
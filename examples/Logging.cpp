@@ -0,0 +1,73 @@
+#include "main/Main.hpp"
+
+// -----------------------------------------------------------------------------
+//                             Logging benchmark
+// -----------------------------------------------------------------------------
+
+// Measures the producer-side cost of deferred and formatted logging from several threads into a binary log,
+// then reads the log back and checks that every message survived
+
+NOVA_EXAMPLE(LogBench, "log")
+{
+    using namespace std::chrono;
+
+    constexpr u32 Threads   = 4;
+    constexpr u32 PerThread = 250'000;
+
+    std::filesystem::path path = args.empty() ? std::filesystem::path("nova-bench.nlog") : std::filesystem::path(args[0]);
+
+    nova::ClearLogSinks();
+    auto binary = std::make_shared<nova::BinaryLogSink>(path);
+    nova::AddLogSink(binary);
+
+    auto Run = [&](auto&& log_fn) {
+        std::vector<std::jthread> threads;
+        auto start = steady_clock::now();
+        for (u32 t = 0; t < Threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (u32 i = 0; i < PerThread; ++i) {
+                    log_fn(t, i);
+                }
+            });
+        }
+        threads.clear();
+        auto end = steady_clock::now();
+        nova::FlushLog();
+        return duration_cast<duration<f64, std::nano>>(end - start).count() / (Threads * PerThread);
+    };
+
+    f64 deferred = Run([](u32 t, u32 i) {
+        LogInfo("thread {} scanned {} ({}, {:.2f}ms)", t, i, "include/nova/core/Core.hpp", 0.25);
+    });
+
+    f64 formatted = Run([](u32 t, u32 i) {
+        nova::Log(nova::LogLevel::Info, "thread {} scanned {} ({}, {:.2f}ms)", t, i, "include/nova/core/Core.hpp", 0.25);
+    });
+
+    nova::RemoveLogSink(binary);
+    binary.reset();
+    nova::AddLogSink(std::make_shared<nova::ConsoleLogSink>());
+
+    u64 messages = 0;
+    u64 deferred_messages = 0;
+    {
+        std::ifstream in(path, std::ios::binary);
+        nova::ReadBinaryLog(in, [&](const nova::LogMessage& message) {
+            messages++;
+            if (message.site) {
+                deferred_messages++;
+            }
+        });
+    }
+
+    nova::Log("deferred:  {:.1f} ns/call", deferred);
+    nova::Log("formatted: {:.1f} ns/call", formatted);
+    nova::Log("read back {} messages ({} deferred) of {}", messages, deferred_messages, 2 * Threads * PerThread);
+
+    // The first run only defers when deferred logging is compiled in, the second always formats
+    constexpr u64 ExpectedDeferred = NOVA_LOG_DEFERRED ? u64(Threads) * PerThread : 0;
+    if (messages != 2ull * Threads * PerThread || deferred_messages != ExpectedDeferred) {
+        NOVA_THROW("Binary log round trip lost messages, read {} ({} deferred), expected {} ({} deferred)",
+            messages, deferred_messages, 2ull * Threads * PerThread, ExpectedDeferred);
+    }
+}
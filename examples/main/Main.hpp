@@ -17,3 +17,14 @@ std::monostate RegisterExample(nova::StringView, ExampleEntryFnPtr fn);
     void example_##name(nova::Span<nova::StringView> args); \
     static auto NOVA_UNIQUE_VAR() = RegisterExample(strName, example_##name); \
     void example_##name([[maybe_unused]] nova::Span<nova::StringView> args)
+
+// Runs fn the given number of times back to back, returns the mean wall time of a single run in seconds
+template<typename Fn>
+f64 MeasureSeconds(u32 rounds, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < rounds; ++i) {
+        fn();
+    }
+    return std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count() / rounds;
+}
@@ -43,7 +43,7 @@ void DetectAndInsertStdModules(BuildState& state)
                             .source{.type = SourceType::CppInterface},
                             .inputs = &source_set.inputs,
                             .unique_name = "std",
-                            .produces = { "std" },
+                            .produces = { String::Intern("std") },
                             .external = true,
                         };
                     }
@@ -59,8 +59,8 @@ void DetectAndInsertStdModules(BuildState& state)
                             .source{.type = SourceType::CppInterface},
                             .inputs = &source_set.inputs,
                             .unique_name = "std.compat",
-                            .produces = { "std.compat" },
-                            .depends_on = { {"std"} },
+                            .produces = { String::Intern("std.compat") },
+                            .depends_on = { { String::Intern("std") } },
                             .external = true,
                         };
                     }
@@ -132,7 +132,7 @@ bool Build(BuildState& state, bool multithreaded)
     {
         // TODO: We should handle this per target, unbuilt targets may remain unexpanded and only contain
         //       output information
-        auto FindTaskForProduced = [&](std::string_view name) -> Task* {
+        auto FindTaskForProduced = [&](const String& name) -> Task* {
             for (auto& task : state.tasks) {
                 for (auto& produced : task.produces) {
                     if (produced == name) return &task;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nova/core/Core.hpp>
+#include <nova/core/VirtualVector.hpp>
 
 using namespace nova;
 
@@ -156,7 +157,7 @@ enum class TaskState
 struct Task;
 
 struct Dependency {
-    std::string name;
+    String name;
     Task* source;
 };
 
@@ -169,7 +170,8 @@ struct Task {
     fs::path obj;
     std::string unique_name;
 
-    std::vector<std::string> produces;
+    // Module names are interned, so matching dependencies against them is a pointer comparison
+    std::vector<String> produces;
     std::vector<Dependency> depends_on;
     bool is_header_unit = false;
 
@@ -182,7 +184,8 @@ struct Task {
 
 struct BuildState
 {
-    std::vector<Task> tasks;
+    // Tasks never move as more are added, so Dependency::source can point into the list
+    VirtualVector<Task> tasks;
     std::unordered_map<std::string, Target> targets;
     const Backend* backend;
     std::vector<fs::path> system_includes;
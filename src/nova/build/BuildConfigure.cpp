@@ -4,7 +4,7 @@ import std.compat;
 #endif
 
 #include "Build.hpp"
-#include <nova/core/Json.hpp>
+#include <nova/core/JsonBinding.hpp>
 
 #ifndef HARMONY_USE_IMPORT_STD
 #include <thread>
@@ -22,6 +22,106 @@ import std.compat;
 fs::path CMakeBuildDirBase = HarmonyDir / "cmake-build";
 fs::path CMakeInstallDirBase = HarmonyDir / "cmake-install";
 
+// -----------------------------------------------------------------------------
+//                            Targets File Schema
+// -----------------------------------------------------------------------------
+
+struct SourceSetDesc
+{
+    std::optional<std::string>                  type;
+    std::optional<std::vector<std::string>> includes;
+    std::optional<std::vector<std::string>>   define;
+    std::vector<std::string>                   paths;
+};
+
+NOVA_JSON_BIND(SourceSetDesc,
+    NOVA_JSON_FIELD("type",     type),
+    NOVA_JSON_FIELD("includes", includes),
+    NOVA_JSON_FIELD("define",   define),
+    NOVA_JSON_FIELD("paths",    paths));
+
+struct ExecutableDesc
+{
+    std::optional<std::string> name;
+    std::optional<std::string> type;
+};
+
+NOVA_JSON_BIND(ExecutableDesc,
+    NOVA_JSON_FIELD("name", name),
+    NOVA_JSON_FIELD("type", type));
+
+NOVA_JSON_BIND(Git,
+    NOVA_JSON_FIELD("url",    url),
+    NOVA_JSON_FIELD("branch", branch));
+
+struct DownloadDesc
+{
+    std::string                 url;
+    std::optional<std::string> type;
+};
+
+NOVA_JSON_BIND(DownloadDesc,
+    NOVA_JSON_FIELD("url",  url),
+    NOVA_JSON_FIELD("type", type));
+
+struct CMakeDesc
+{
+    std::vector<std::string>                options;
+    std::optional<std::vector<std::string>> include;
+    std::optional<std::vector<std::string>>    link;
+    std::optional<std::vector<std::string>>  shared;
+};
+
+NOVA_JSON_BIND(CMakeDesc,
+    NOVA_JSON_FIELD("options", options),
+    NOVA_JSON_FIELD("include", include),
+    NOVA_JSON_FIELD("link",    link),
+    NOVA_JSON_FIELD("shared",  shared));
+
+struct TargetDesc
+{
+    std::string                                          name;
+    std::optional<std::string>                            dir;
+    std::vector<std::string>                          include;
+    std::vector<std::string>                           define;
+    std::vector<std::string>                           shared;
+    std::vector<std::variant<std::string, SourceSetDesc>> sources;
+    std::vector<std::string>                          imports;
+    std::vector<std::string>                   public_imports;
+    std::vector<std::string>                interface_imports;
+    std::vector<std::string>                            links;
+    std::optional<std::variant<bool, ExecutableDesc>> executable;
+    std::optional<std::variant<std::string, Git>>          git;
+    std::optional<DownloadDesc>                      download;
+    std::optional<CMakeDesc>                            cmake;
+};
+
+NOVA_JSON_BIND(TargetDesc,
+    NOVA_JSON_FIELD("name",             name),
+    NOVA_JSON_FIELD("dir",              dir),
+    NOVA_JSON_FIELD("include",          include),
+    NOVA_JSON_FIELD("define",           define),
+    NOVA_JSON_FIELD("shared",           shared),
+    NOVA_JSON_FIELD("sources",          sources),
+    NOVA_JSON_FIELD("import",           imports),
+    NOVA_JSON_FIELD("import-public",    public_imports),
+    NOVA_JSON_FIELD("import-interface", interface_imports),
+    NOVA_JSON_FIELD("link",             links),
+    NOVA_JSON_FIELD("executable",       executable),
+    NOVA_JSON_FIELD("git",              git),
+    NOVA_JSON_FIELD("download",         download),
+    NOVA_JSON_FIELD("cmake",            cmake));
+
+struct TargetsFileDesc
+{
+    std::vector<TargetDesc> targets;
+};
+
+NOVA_JSON_BIND(TargetsFileDesc,
+    NOVA_JSON_FIELD("targets", targets));
+
+// -----------------------------------------------------------------------------
+
 void ParseTargetsFile(BuildState& state, const fs::path& file, std::string_view config)
 {
     LogInfo("Parsing targets file");
@@ -30,14 +130,16 @@ void ParseTargetsFile(BuildState& state, const fs::path& file, std::string_view
     fs::create_directories(deps_folder);
     JsonDocument doc(config);
 
-    for (auto in_target :  doc.root()["targets"]) {
-        auto name = in_target["name"].string();
+    auto targets_file = JsonRead<TargetsFileDesc>(doc.root());
+
+    for (auto& in_target : targets_file.targets) {
+        auto& name = in_target.name;
 
         fs::path dir;
-        if (auto dir_str = in_target["dir"].string()) {
-            LogTrace("Custom dir path: {}", dir_str);
-            dir = dir_str;
-        } else if (in_target["git"] || in_target["download"]) {
+        if (in_target.dir) {
+            LogTrace("Custom dir path: {}", *in_target.dir);
+            dir = *in_target.dir;
+        } else if (in_target.git || in_target.download) {
             dir = deps_folder / name;
         } else {
             dir = file.parent_path();
@@ -50,64 +152,61 @@ void ParseTargetsFile(BuildState& state, const fs::path& file, std::string_view
         out_target.name = name;
         out_target.dir = dir;
 
-        for (auto include : in_target["include"]) {
-            out_target.exported_translation_inputs.include_dirs.emplace_back(dir / include.string());
+        for (auto& include : in_target.include) {
+            out_target.exported_translation_inputs.include_dirs.emplace_back(dir / include);
         }
 
-        for (auto define : in_target["define"]) {
-            out_target.exported_translation_inputs.defines.emplace_back(define.string());
+        for (auto& define : in_target.define) {
+            out_target.exported_translation_inputs.defines.emplace_back(std::move(define));
         }
 
-        for (auto shared : in_target["shared"]) {
-            out_target.shared.emplace_back(dir / shared.string());
+        for (auto& shared : in_target.shared) {
+            out_target.shared.emplace_back(dir / shared);
         }
 
         SourceSet default_source_set;
         default_source_set.inputs = out_target.exported_translation_inputs;
 
-        for (auto source : in_target["sources"]) {
-            if (source.obj()) {
-                auto type_str = source["type"].string();
-                if (type_str) {
-                    LogTrace("  sources(type = {})", type_str);
+        for (auto& source : in_target.sources) {
+            if (auto* set = std::get_if<SourceSetDesc>(&source)) {
+                if (set->type) {
+                    LogTrace("  sources(type = {})", *set->type);
                 } else {
                     LogTrace("  sources");
                 }
 
                 auto type = [&] {
-                    if (!type_str) return SourceType::Unknown;
-                    if ("c"sv == type_str) return SourceType::CSource;
-                    if ("c++"sv == type_str) return SourceType::CppSource;
-                    if ("c++header"sv == type_str) return SourceType::CppHeader;
-                    if ("c++interface"sv == type_str) return SourceType::CppInterface;
-                    NOVA_THROW(std::format("Unknown source type: [{}]", type_str));
+                    if (!set->type) return SourceType::Unknown;
+                    if ("c" == *set->type) return SourceType::CSource;
+                    if ("c++" == *set->type) return SourceType::CppSource;
+                    if ("c++header" == *set->type) return SourceType::CppHeader;
+                    if ("c++interface" == *set->type) return SourceType::CppInterface;
+                    NOVA_THROW(std::format("Unknown source type: [{}]", *set->type));
                 }();
 
                 auto& source_set = out_target.sources.emplace_back();
                 source_set.inputs = out_target.exported_translation_inputs;
                 source_set.inputs.type = type;
 
-                if (auto includes = source["includes"]) {
+                if (set->includes) {
                     source_set.inputs.include_dirs.clear();
-                    for (auto include : includes) {
-                        source_set.inputs.include_dirs.emplace_back(dir / include.string());
+                    for (auto& include : *set->includes) {
+                        source_set.inputs.include_dirs.emplace_back(dir / include);
                     }
                 }
 
-                if (auto defines = source["define"]) {
-                    source_set.inputs.defines.clear();
-                    for (auto define : defines) {
-                        source_set.inputs.defines.emplace_back(define.string());
-                    }
+                if (set->define) {
+                    source_set.inputs.defines = std::move(*set->define);
                 }
 
-                for (auto file : source["paths"]) {
-                    LogTrace("    {}", file.string());
-                    source_set.sources.emplace_back(dir / file.string());
+                for (auto& path : set->paths) {
+                    LogTrace("    {}", path);
+                    source_set.sources.emplace_back(dir / path);
                 }
             } else {
-                LogTrace("  source: {}", source.string());
-                default_source_set.sources.emplace_back(dir / source.string());
+                auto& path = std::get<std::string>(source);
+                LogTrace("  source: {}", path);
+                default_source_set.sources.emplace_back(dir / path);
             }
         }
 
@@ -115,87 +214,78 @@ void ParseTargetsFile(BuildState& state, const fs::path& file, std::string_view
             out_target.sources.emplace_back(std::move(default_source_set));
         }
 
-        for (auto import : in_target["import"]) {
-            out_target.imported_targets[import.string()] = DependencyType::Private;
+        for (auto& import : in_target.imports) {
+            out_target.imported_targets[import] = DependencyType::Private;
         }
 
-        for (auto import : in_target["import-public"]) {
-            out_target.imported_targets[import.string()] = DependencyType::Public;
+        for (auto& import : in_target.public_imports) {
+            out_target.imported_targets[import] = DependencyType::Public;
         }
 
-        for (auto import : in_target["import-interface"]) {
-            out_target.imported_targets[import.string()] = DependencyType::Interface;
+        for (auto& import : in_target.interface_imports) {
+            out_target.imported_targets[import] = DependencyType::Interface;
         }
 
-        for (auto link : in_target["link"]) {
-            out_target.links.emplace_back(dir / link.string());
+        for (auto& link : in_target.links) {
+            out_target.links.emplace_back(dir / link);
         }
 
-        if (auto executable = in_target["executable"]) {
+        if (in_target.executable) {
+            auto* executable = std::get_if<ExecutableDesc>(&*in_target.executable);
             out_target.executable.emplace(
+                executable && executable->name ? *executable->name : out_target.name,
                 [&] {
-                    auto exe_name = executable["name"].string();
-                    return exe_name ? exe_name : out_target.name;
-                }(),
-                [&] {
-                    auto type_str = executable["type"].string();
-                    if (!type_str) return ExecutableType::Console;
-                    if ("console"sv == type_str) return ExecutableType::Console;
-                    if ("window"sv == type_str) return ExecutableType::Window;
-                    NOVA_THROW(std::format("Unknown executable type: [{}] (expected [console] or [window])", type_str));
+                    if (!executable || !executable->type) return ExecutableType::Console;
+                    if ("console" == *executable->type) return ExecutableType::Console;
+                    if ("window" == *executable->type) return ExecutableType::Window;
+                    NOVA_THROW(std::format("Unknown executable type: [{}] (expected [console] or [window])", *executable->type));
                 }()
             );
         }
 
-        if (auto in_git = in_target["git"]) {
-            auto& git = out_target.git.emplace();
-            if (in_git.string()) {
-                git.url = in_git.string();
+        if (in_target.git) {
+            if (auto* url = std::get_if<std::string>(&*in_target.git)) {
+                out_target.git.emplace().url = std::move(*url);
             } else {
-                git.url = in_git["url"].string();
-                if (auto branch = in_git["branch"]) {
-                    git.branch = branch.string();
-                }
+                out_target.git = std::move(std::get<Git>(*in_target.git));
             }
         }
 
-        if (auto in_download = in_target["download"]) {
+        if (in_target.download) {
             auto& download = out_target.download.emplace();
-            download.url = in_download["url"].string();
-            if (auto type = in_download["type"].string()) {
-                if ("zip"sv == type) download.type = ArchiveType::Zip;
-                else if ("targz"sv == type) download.type = ArchiveType::TarGz;
-                else NOVA_THROW("Unknown download type: {}", type);
+            download.url = std::move(in_target.download->url);
+            if (auto& type = in_target.download->type) {
+                if ("zip" == *type) download.type = ArchiveType::Zip;
+                else if ("targz" == *type) download.type = ArchiveType::TarGz;
+                else NOVA_THROW("Unknown download type: {}", *type);
             }
         }
 
-        if (auto in_cmake = in_target["cmake"]) {
+        if (in_target.cmake) {
             auto& cmake = out_target.cmake.emplace();
-            for (auto option : in_cmake["options"]) {
-                cmake.options.emplace_back(option.string());
-            }
+            cmake.options = std::move(in_target.cmake->options);
 
             fs::path install_dir = CMakeInstallDirBase / name;
 
-            if (auto include_range = in_cmake["include"]) {
-                for (auto include : include_range) {
-                    out_target.exported_translation_inputs.include_dirs.emplace_back(install_dir / include.string());
+            if (in_target.cmake->include) {
+                for (auto& include : *in_target.cmake->include) {
+                    out_target.exported_translation_inputs.include_dirs.emplace_back(install_dir / include);
                 }
             } else {
                 out_target.exported_translation_inputs.include_dirs.emplace_back(install_dir / "include");
             }
 
-            if (auto link_range = in_cmake["link"]) {
-                for (auto link : link_range) {
-                    out_target.links.emplace_back(install_dir / link.string());
+            if (in_target.cmake->link) {
+                for (auto& link : *in_target.cmake->link) {
+                    out_target.links.emplace_back(install_dir / link);
                 }
             } else {
                 out_target.links.emplace_back(install_dir / "lib");
             }
 
-            if (auto shared_range = in_cmake["shared"]) {
-                for (auto shared : shared_range) {
-                    out_target.shared.emplace_back(install_dir / shared.string());
+            if (in_target.cmake->shared) {
+                for (auto& shared : *in_target.cmake->shared) {
+                    out_target.shared.emplace_back(install_dir / shared);
                 }
             } else {
                 out_target.shared.emplace_back(install_dir / "bin");
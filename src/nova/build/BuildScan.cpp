@@ -8,7 +8,10 @@ import std.compat;
 #include "Build.hpp"
 #include "backend/Backend.hpp"
 
+#include <nova/core/Arena.hpp>
 #include <nova/core/Json.hpp>
+#include <nova/core/Parallel.hpp>
+#include <nova/core/Profile.hpp>
 #include <xxhash.h>
 
 #include <math.h>
@@ -33,6 +36,8 @@ bool wsnl(char c)
 
 ScanResult ScanFile(const fs::path& path, std::string& data, FunctionRef<void(Component&)> callback)
 {
+    NOVA_PROFILE_SCOPE("ScanFile");
+
     std::ifstream in(path, std::ios::binary | std::ios::ate);
     if (!in.is_open()) {
         // TODO: Is this recoverable?
@@ -370,20 +375,22 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
 {
     LogInfo("Scanning dependencies");
 
-    std::unordered_map<fs::path, std::string> marked_header_units;
+    std::unordered_map<fs::path, String> marked_header_units;
 
     auto backend_scan_differences = 0;
 
     std::vector<std::string> dependency_info;
     if (use_backend_dependency_scan) {
         dependency_info.resize(state.tasks.size());
-#pragma omp parallel for
-        for (uint32_t i = 0; i < state.tasks.size(); ++i) {
+        ParallelFor(state.tasks.size(), 1, [&](u64 i) {
             state.backend->FindDependencies(state.tasks[i], dependency_info[i]);
-        }
+        });
     }
 
     {
+        // Dependency documents are parsed in place and their DOMs bump allocated, reusing the same pages for every task
+        Arena json_arena(256ull * 1024 * 1024);
+
         std::string scan_storage;
         std::unordered_map<std::string, int> produced_set;
         std::unordered_map<std::string, int> required_set;
@@ -397,24 +404,28 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
 
                 LogDebug("  Backend results:");
 
-                JsonDocument doc(dependency_info[i]);
+                NOVA_ARENA_SCOPE(json_arena);
+                auto& info = dependency_info[i];
+                auto info_size = info.size();
+                info.append(JsonDocument::InSituPadding, '\0');
+                JsonDocument doc(info.data(), info_size, &json_arena);
                 for (auto rule : doc.root()["rules"]) {
                     for (auto provided : rule["provides"]) {
                         auto logical_name = provided["logical-name"].string();
                         produced_set[logical_name]++;
                         LogTrace("produces module [{}]", logical_name);
-                        task.produces.emplace_back(logical_name);
+                        task.produces.emplace_back(String::Intern(logical_name));
                     }
 
                     for (auto required : rule["requires"]) {
                         auto logical_name = required["logical-name"].string();
                         required_set[logical_name]++;
                         // LogTrace("  requires: {}", logical_name);
-                        task.depends_on.emplace_back(Dependency{.name = std::string(logical_name)});
+                        task.depends_on.emplace_back(Dependency{.name = String::Intern(logical_name)});
                         if (auto source_path = required["source-path"]) {
                             auto path = fs::path(source_path.string());
                             // LogTrace("    is header unit - {}", path.string());
-                            marked_header_units[path] = logical_name;
+                            marked_header_units[path] = String::Intern(logical_name);
                             LogTrace("requires header [{}]", path.string());
                         } else {
                             LogTrace("requires module [{}]", logical_name);
@@ -435,7 +446,7 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
                         if (use_backend_dependency_scan) {
                             produced_set[comp.name]--;
                         } else {
-                            task.produces.emplace_back(std::move(comp.name));
+                            task.produces.emplace_back(String::Intern(comp.name));
                         }
                     } else {
                         if (comp.type == Component::Type::HeaderUnit) {
@@ -447,7 +458,7 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
                             }
                             auto path = fs::absolute(*included);
 
-                            marked_header_units[path] = comp.name;
+                            marked_header_units[path] = String::Intern(comp.name);
 
                             if (is_system) {
                                 // TODO: We should track these per source instead of per target
@@ -458,7 +469,7 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
                         if (use_backend_dependency_scan) {
                             required_set[comp.name]--;
                         } else {
-                            task.depends_on.emplace_back(Dependency{.name = std::move(comp.name)});
+                            task.depends_on.emplace_back(Dependency{.name = String::Intern(comp.name)});
                         }
                     }
                 }
@@ -534,18 +545,18 @@ void ScanDependencies(BuildState& state, bool use_backend_dependency_scan)
 
     LogDebug("Trimming normal header tasks");
 
-    std::erase_if(state.tasks, [](const auto& task) {
+    state.tasks.erase(std::remove_if(state.tasks.begin(), state.tasks.end(), [](const auto& task) {
         if (!task.is_header_unit && task.source.type == SourceType::CppHeader) {
             LogTrace("Header [{}] is not consumed as a header unit", task.unique_name);
             return true;
         }
         return false;
-    });
+    }), state.tasks.end());
 }
 void SortDependencies(BuildState& state)
 {
     // TODO: Don't duplicate this, inefficient anyway!
-    auto FindTaskForProduced = [&](std::string_view name) -> Task* {
+    auto FindTaskForProduced = [&](const String& name) -> Task* {
         for (auto& task : state.tasks) {
             for (auto& produced : task.produces) {
                 if (produced == name) return &task;
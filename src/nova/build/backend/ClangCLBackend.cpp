@@ -107,7 +107,7 @@ bool ClangClBackend::CompileTask(const Task& task) const
     }
 
     // TODO: FIXME - Should this be handled by shared build logic?
-    std::unordered_set<std::string_view> seen;
+    HashSet<String> seen;
     auto AddDependencies = [&cmds, &seen](this auto&& self, const Task& task) -> void {
         for (auto& depends_on : task.depends_on) {
 
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "Core.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                                  Arena
+// -----------------------------------------------------------------------------
+
+    // Bump allocator over a single reserved range of virtual memory.
+    //
+    // Address space is reserved up front and pages are committed in blocks of the commit granularity as the
+    // arena grows, so a large reservation only costs what is actually touched. Allocations are never freed
+    // individually, instead the arena is rewound to a marker or reset as a whole.
+    //
+    // Reset() decommits any pages above the high-water mark reached since the previous Reset(), keeping at least
+    // the retained size committed. An arena whose working set shrinks returns its memory after one idle cycle,
+    // while one that is reset every frame at a steady size never touches the OS.
+
+    class Arena
+    {
+        std::byte*      base = nullptr;
+        std::byte*       ptr = nullptr;
+        std::byte* committed = nullptr;
+        std::byte*       end = nullptr;
+        std::byte*      peak = nullptr; // High-water mark as of the last rewind
+
+        usz commit_size = 0;
+        usz retain_size = 0;
+
+    public:
+        static constexpr usz DefaultReserveSize = 16ull * 1024 * 1024 * 1024;
+        static constexpr usz  DefaultCommitSize = 64ull * 1024;
+        static constexpr usz  DefaultRetainSize = 1ull * 1024 * 1024;
+
+        struct Marker
+        {
+            std::byte* ptr;
+        };
+
+    public:
+        explicit Arena(usz reserve = DefaultReserveSize, usz commit_granularity = DefaultCommitSize, usz retain = DefaultRetainSize)
+            : commit_size(std::bit_ceil(std::max(commit_granularity, usz(4096))))
+            , retain_size(retain)
+        {
+            reserve = AlignUpPower2(std::max(reserve, commit_size), commit_size);
+            base = static_cast<std::byte*>(AllocVirtual(AllocationType::Reserve, reserve));
+            if (!base) {
+                NOVA_THROW("Failed to reserve {} for arena", ByteSizeToString(reserve));
+            }
+            ptr = committed = peak = base;
+            end = base + reserve;
+        }
+
+        ~Arena()
+        {
+            if (base) {
+                FreeVirtual(FreeType::Release, base);
+            }
+        }
+
+        Arena(Arena&& other) noexcept
+            : base(std::exchange(other.base, nullptr))
+            , ptr(std::exchange(other.ptr, nullptr))
+            , committed(std::exchange(other.committed, nullptr))
+            , end(std::exchange(other.end, nullptr))
+            , peak(std::exchange(other.peak, nullptr))
+            , commit_size(other.commit_size)
+            , retain_size(other.retain_size)
+        {}
+
+        Arena& operator=(Arena&& other) noexcept
+        {
+            if (this != &other) {
+                this->~Arena();
+                new (this) Arena(std::move(other));
+            }
+            return *this;
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        NOVA_FORCE_INLINE
+        void* Allocate(usz size, usz align = alignof(std::max_align_t))
+        {
+            std::byte* p = AlignUpPower2(ptr, align);
+            if (p > committed || size > usz(committed - p)) [[unlikely]] {
+                Grow(p, size);
+            }
+            ptr = p + size;
+            return p;
+        }
+
+        template<typename T>
+        T* Allocate(usz count = 1)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Constructs an object in the arena. Destructors are never run, so this is intended for trivially
+        // destructible types or objects whose lifetimes are managed by the caller
+        template<typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Returns memory only when it is the most recent allocation, letting growing containers extend in place
+        void Free(void* p, usz size) noexcept
+        {
+            if (static_cast<std::byte*>(p) + size == ptr) {
+                peak = std::max(peak, ptr);
+                ptr = static_cast<std::byte*>(p);
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        Marker GetMarker() const noexcept
+        {
+            return { ptr };
+        }
+
+        // Frees everything allocated after the marker was taken. Committed pages are kept for reuse
+        void Reset(Marker marker)
+        {
+            NOVA_ASSERT(marker.ptr >= base && marker.ptr <= ptr, "Arena marker is not valid for the current allocation state");
+            peak = std::max(peak, ptr);
+            ptr = marker.ptr;
+        }
+
+        // Frees all allocations and decommits pages that were not used since the previous reset
+        void Reset() noexcept
+        {
+            peak = std::max(peak, ptr);
+            ptr = base;
+            Decommit(std::max(peak, base + std::min(retain_size, usz(end - base))));
+            peak = base;
+        }
+
+        // Immediately decommits all pages above the current allocation, keeping the given number of bytes committed
+        void Trim(usz retain = 0) noexcept
+        {
+            Decommit(ptr + std::min(retain, usz(end - ptr)));
+        }
+
+// -----------------------------------------------------------------------------
+
+        usz GetUsed() const noexcept
+        {
+            return usz(ptr - base);
+        }
+
+        usz GetCommitted() const noexcept
+        {
+            return usz(committed - base);
+        }
+
+        usz GetReserved() const noexcept
+        {
+            return usz(end - base);
+        }
+
+    private:
+        NOVA_NO_INLINE
+        void Grow(std::byte* p, usz size)
+        {
+            if (p > end || size > usz(end - p)) {
+                NOVA_THROW("Arena out of reserved memory, requested {} with {} of {} used",
+                    ByteSizeToString(size), ByteSizeToString(GetUsed()), ByteSizeToString(GetReserved()));
+            }
+
+            std::byte* target = std::min(AlignUpPower2(p + size, commit_size), end);
+            if (!AllocVirtual(AllocationType::Commit, usz(target - committed), committed)) {
+                NOVA_THROW("Failed to commit {} for arena", ByteSizeToString(usz(target - committed)));
+            }
+            committed = target;
+        }
+
+        void Decommit(std::byte* keep) noexcept
+        {
+            keep = AlignUpPower2(keep, commit_size);
+            if (keep < committed) {
+                FreeVirtual(FreeType::Decommit, keep, usz(committed - keep));
+                committed = keep;
+            }
+        }
+    };
+
+    // Rewinds an arena to its state at construction when leaving scope
+
+    class ArenaScope
+    {
+        Arena&           arena;
+        Arena::Marker   marker;
+
+    public:
+        explicit ArenaScope(Arena& _arena) noexcept
+            : arena(_arena)
+            , marker(_arena.GetMarker())
+        {}
+
+        ~ArenaScope() noexcept
+        {
+            arena.Reset(marker);
+        }
+
+        ArenaScope(const ArenaScope&) = delete;
+        auto operator=(const ArenaScope&) = delete;
+        ArenaScope(ArenaScope&&) = delete;
+        auto operator=(ArenaScope&&) = delete;
+    };
+
+#define NOVA_ARENA_SCOPE(arena) ::nova::ArenaScope NOVA_UNIQUE_VAR()(arena)
+
+// -----------------------------------------------------------------------------
+//                              Arena Allocator
+// -----------------------------------------------------------------------------
+
+    // Standard allocator adaptor, containers using it share the arena's lifetime and must not outlive a reset
+
+    template<typename T>
+    struct ArenaAllocator
+    {
+        using value_type = T;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        Arena* arena;
+
+        ArenaAllocator(Arena& _arena) noexcept
+            : arena(&_arena)
+        {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+            : arena(other.arena)
+        {}
+
+        T* allocate(usz count)
+        {
+            if (count > std::numeric_limits<usz>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return arena->Allocate<T>(count);
+        }
+
+        void deallocate(T* p, usz count) noexcept
+        {
+            arena->Free(p, sizeof(T) * count);
+        }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept
+        {
+            return arena == other.arena;
+        }
+    };
+
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    template<typename K, typename V>
+    using ArenaHashMap = ankerl::unordered_dense::map<K, V,
+        ankerl::unordered_dense::hash<K>, std::equal_to<K>, ArenaAllocator<std::pair<K, V>>>;
+
+    template<typename E>
+    using ArenaHashSet = ankerl::unordered_dense::set<E,
+        ankerl::unordered_dense::hash<E>, std::equal_to<E>, ArenaAllocator<E>>;
+}
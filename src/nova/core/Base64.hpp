@@ -36,113 +36,197 @@ namespace nova
             constexpr static Table URL     = Table('.', "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
         };
 
+// -----------------------------------------------------------------------------
+//                                  Sizing
+// -----------------------------------------------------------------------------
+
+        constexpr
+        usz EncodedSize(usz size, bool pad = true)
+        {
+            usz full_triple_count = size / 3;
+            switch (size - full_triple_count * 3) {
+                break;case 1: return full_triple_count * 4 + (pad ? 4 : 2); // xx==
+                break;case 2: return full_triple_count * 4 + (pad ? 4 : 3); // xxx=
+            }
+            return full_triple_count * 4;
+        }
+
+        // Size of the decoded data assuming valid input, padding is only recognized in the final quad
         inline
-        usz Encode(void* output, usz output_size, const void* input, usz size, bool pad = true, const Table& table = tables::Default)
+        usz DecodedSize(const void* input, usz size, const Table& table = tables::Default)
+        {
+            const char* encoded = reinterpret_cast<const char*>(input);
+            if (size >= 4 && size % 4 == 0) {
+                if      (table.decode[u8(encoded[size - 2])] == Padding) size -= 2;
+                else if (table.decode[u8(encoded[size - 1])] == Padding) size -= 1;
+            }
+
+            usz full_quad_count = size / 4;
+            switch (size - full_quad_count * 4) {
+                break;case 2: return full_quad_count * 3 + 1;
+                break;case 3: return full_quad_count * 3 + 2;
+            }
+            return full_quad_count * 3;
+        }
+
+// -----------------------------------------------------------------------------
+//                              Scalar fallback
+// -----------------------------------------------------------------------------
+
+        namespace detail
         {
-            usz full_triple_count    =  size      / 3;
-            usz rounded_triple_count = (size + 2) / 3;
-            usz remainder = size - (full_triple_count * 3);
-
-            usz expected_size = rounded_triple_count * 4;
-            if (!pad) {
-                switch (remainder) {
-                    break;case 1: expected_size -= 2; // xx==
-                    break;case 2: expected_size -= 1; // xxx=
+            inline
+            usz EncodeScalar(char* encoded, const u8* data, usz size, bool pad, const Table& table)
+            {
+                usz full_triple_count = size / 3;
+                usz remainder = size - (full_triple_count * 3);
+
+                for (usz i = 0; i < full_triple_count; ++i) {
+                    usz oi = i * 4;
+                    usz ii = i * 3;
+                    encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
+                    encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) + (data[ii + 1] >> 4)];
+                    encoded[oi + 2] = table.encode[((data[ii + 1] & 0x0f) << 2) + (data[ii + 2] >> 6)];
+                    encoded[oi + 3] = table.encode[  data[ii + 2] & 0x3f                             ];
+                }
+
+                if (remainder) {
+                    usz oi = full_triple_count * 4;
+                    usz ii = full_triple_count * 3;
+                    switch (remainder) {
+                        break;case 1:
+                            encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
+                            encoded[oi + 1] = table.encode[(data[ii + 0] & 0x03) << 4                        ];
+                            if (pad) {
+                                encoded[oi + 2] = table.padding;
+                                encoded[oi + 3] = table.padding;
+                            }
+                        break;case 2:
+                            encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
+                            encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) | (data[ii + 1] >> 4)];
+                            encoded[oi + 2] = table.encode[( data[ii + 1] & 0x0f) << 2];
+                            if (pad) {
+                                encoded[oi + 3] = table.padding;
+                            }
+                    }
+                }
+
+                return EncodedSize(size, pad);
+            }
+
+            // Expects padding to have been stripped
+            inline
+            usz DecodeScalar(u8* data, const char* encoded, usz size, const Table& table)
+            {
+                usz full_quad_count = size / 4;
+                usz remainder = size - (full_quad_count * 4);
+
+                for (usz i = 0; i < full_quad_count; ++i) {
+                    usz di = i * 3;
+                    usz ei = i * 4;
+                    u8 e0 = table.decode[u8(encoded[ei + 0])];
+                    u8 e1 = table.decode[u8(encoded[ei + 1])];
+                    u8 e2 = table.decode[u8(encoded[ei + 2])];
+                    u8 e3 = table.decode[u8(encoded[ei + 3])];
+                    data[di + 0] = (e0 << 2) | (e1 >> 4);
+                    data[di + 1] = (e1 << 4) | (e2 >> 2);
+                    data[di + 2] = (e2 << 6) |  e3;
                 }
+
+                usz di = full_quad_count * 3;
+                if (remainder >= 2) {
+                    usz ei = full_quad_count * 4;
+                    u8 e0 = table.decode[u8(encoded[ei + 0])];
+                    u8 e1 = table.decode[u8(encoded[ei + 1])];
+                    u8 e2 = table.decode[u8(encoded[ei + 2])];
+                                        data[di++] = (e0 << 2) | (e1 >> 4);
+                    if (remainder == 3) data[di++] = (e1 << 4) | (e2 >> 2);
+                }
+
+                return di;
             }
 
+            // The built-in alphabets are handed to simdutf, which picks AVX-512, AVX2, SSE4.2 or NEON kernels at
+            // runtime. Padding is always handled here since the URL table pads with '.'
+            enum class SimdAlphabet
+            {
+                None,
+                Default,
+                URL,
+            };
+
+            inline
+            SimdAlphabet GetSimdAlphabet(const Table& table)
+            {
+                if (std::memcmp(table.encode, tables::Default.encode, 64) == 0) return SimdAlphabet::Default;
+                if (std::memcmp(table.encode,     tables::URL.encode, 64) == 0) return SimdAlphabet::URL;
+                return SimdAlphabet::None;
+            }
+        }
+
+// -----------------------------------------------------------------------------
+//                                One-shot API
+// -----------------------------------------------------------------------------
+
+        // Returns the encoded size, output is only written if it is large enough to hold the result
+        inline
+        usz Encode(void* output, usz output_size, const void* input, usz size, bool pad = true, const Table& table = tables::Default)
+        {
+            usz expected_size = EncodedSize(size, pad);
             if (expected_size > output_size) return expected_size;
 
             const u8* data = reinterpret_cast<const u8*>(input);
             char* encoded = reinterpret_cast<char*>(output);
 
-            for (usz i = 0; i < full_triple_count; ++i) {
-                usz oi = i * 4;
-                usz ii = i * 3;
-                encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) + (data[ii + 1] >> 4)];
-                encoded[oi + 2] = table.encode[((data[ii + 1] & 0x0f) << 2) + (data[ii + 2] >> 6)];
-                encoded[oi + 3] = table.encode[  data[ii + 2] & 0x3f                             ];
-            }
-
-            if (remainder) {
-                usz oi = full_triple_count * 4;
-                usz ii = full_triple_count * 3;
-                switch (remainder) {
-                    break;case 1:
-                        encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                        encoded[oi + 1] = table.encode[(data[ii + 0] & 0x03) << 4                        ];
-                        if (pad) {
-                            encoded[oi + 2] = table.padding;
-                            encoded[oi + 3] = table.padding;
-                        }
-                    break;case 2:
-                        encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                        encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) | (data[ii + 1] >> 4)];
-                        encoded[oi + 2] = table.encode[( data[ii + 1] & 0x0f) << 2];
-                        if (pad) {
-                            encoded[oi + 3] = table.padding;
-                        }
-                }
+            simdutf::base64_options options;
+            switch (detail::GetSimdAlphabet(table)) {
+                break;case detail::SimdAlphabet::Default: options = simdutf::base64_default_no_padding;
+                break;case detail::SimdAlphabet::URL:     options = simdutf::base64_url;
+                break;default: return detail::EncodeScalar(encoded, data, size, pad, table);
+            }
+
+            usz written = simdutf::binary_to_base64(reinterpret_cast<const char*>(data), size, encoded, options);
+            while (written < expected_size) {
+                encoded[written++] = table.padding;
             }
 
             return expected_size;
         }
 
+        // Returns the decoded size if output is too small to hold the result, otherwise decodes and returns the
+        // number of bytes written. Built-in tables are validated and throw on invalid characters
         inline
         usz Decode(void* output, usz output_size, const void* input, usz size, const Table& table = tables::Default)
         {
-            usz full_quad_count    =  size      / 4;
-            usz remainder = size - (full_quad_count * 4);
+            usz expected_size = DecodedSize(input, size, table);
+            if (expected_size > output_size) return expected_size;
 
             u8* data = reinterpret_cast<u8*>(output);
             const char* encoded = reinterpret_cast<const char*>(input);
 
-            // Check for padding in last quad
-            if (full_quad_count > 0) {
-                const char* last_quad = encoded + (full_quad_count - 1) * 4;
-                if      (table.decode[last_quad[2]] == Padding) { full_quad_count--; remainder = 2; }
-                else if (table.decode[last_quad[3]] == Padding) { full_quad_count--; remainder = 3; }
+            while (size > 0 && table.decode[u8(encoded[size - 1])] == Padding) {
+                size--;
             }
 
-            // Compute size
-            usz expected_size = full_quad_count * 3;
-            switch (remainder) {
-                break;case 2: expected_size += 1;
-                break;case 3: expected_size += 2;
+            simdutf::base64_options options;
+            switch (detail::GetSimdAlphabet(table)) {
+                break;case detail::SimdAlphabet::Default: options = simdutf::base64_default;
+                break;case detail::SimdAlphabet::URL:     options = simdutf::base64_url;
+                break;default: return detail::DecodeScalar(data, encoded, size, table);
             }
 
-            if (expected_size > output_size) return expected_size;
-
-            for (usz i = 0; i < full_quad_count; ++i) {
-                usz di = i * 3;
-                usz ei = i * 4;
-                u8 e0 = table.decode[encoded[ei + 0]];
-                u8 e1 = table.decode[encoded[ei + 1]];
-                u8 e2 = table.decode[encoded[ei + 2]];
-                u8 e3 = table.decode[encoded[ei + 3]];
-                data[di + 0] = (e0 << 2) | (e1 >> 4);
-                data[di + 1] = (e1 << 4) | (e2 >> 2);
-                data[di + 2] = (e2 << 6) |  e3;
+            auto result = simdutf::base64_to_binary(encoded, size, reinterpret_cast<char*>(data), options);
+            if (result.error != simdutf::error_code::SUCCESS) {
+                NOVA_THROW("Invalid base64 input at offset {}", result.count);
             }
 
-            if (remainder) {
-                usz di = full_quad_count * 3;
-                usz ei = full_quad_count * 4;
-                u8 e0 = table.decode[encoded[ei + 0]];
-                u8 e1 = table.decode[encoded[ei + 1]];
-                u8 e2 = table.decode[encoded[ei + 2]];
-                                    data[di + 0] = (e0 << 2) | (e1 >> 4);
-                if (remainder == 3) data[di + 1] = (e1 << 4) | (e2 >> 2);
-            }
-
-            return expected_size;
+            return result.count;
         }
 
         inline
         std::string EncodeToString(Span<b8> bytes, bool pad = true, const Table& table = tables::Default)
         {
-            std::string str(Encode(nullptr, 0, bytes.data(), bytes.size(), pad, table), '\0');
+            std::string str(EncodedSize(bytes.size(), pad), '\0');
             Encode(str.data(), str.size(), bytes.data(), bytes.size(), pad, table);
             return str;
         }
@@ -150,17 +234,187 @@ namespace nova
         inline
         std::vector<b8> DecodeToVector(std::string_view encoded, const Table& table = tables::Default)
         {
-            std::vector<b8> dec(Decode(nullptr, 0, encoded.data(), encoded.size(), table));
-            Decode(dec.data(), dec.size(), encoded.data(), encoded.size(), table);
+            std::vector<b8> dec(DecodedSize(encoded.data(), encoded.size(), table));
+            dec.resize(Decode(dec.data(), dec.size(), encoded.data(), encoded.size(), table));
             return dec;
         }
 
         inline
         std::string DecodeToString(std::string_view encoded, const Table& table = tables::Default)
         {
-            std::string dec(Decode(nullptr, 0, encoded.data(), encoded.size(), table), '\0');
-            Decode(dec.data(), dec.size(), encoded.data(), encoded.size(), table);
+            std::string dec(DecodedSize(encoded.data(), encoded.size(), table), '\0');
+            dec.resize(Decode(dec.data(), dec.size(), encoded.data(), encoded.size(), table));
             return dec;
         }
+
+// -----------------------------------------------------------------------------
+//                                 Streaming
+// -----------------------------------------------------------------------------
+
+        // Incremental encoder, input can be fed in arbitrarily sized pieces and the concatenated output is identical
+        // to a single Encode call. Bytes that don't fill a whole triple are carried over to the next Update
+        class Encoder
+        {
+            const Table* table;
+            bool           pad;
+
+            u8  pending[3] = {};
+            u32 pending_count = 0;
+
+        public:
+            explicit Encoder(bool _pad = true, const Table& _table = tables::Default)
+                : table(&_table)
+                , pad(_pad)
+            {}
+
+            // Exact number of characters the next Update(size) will write
+            usz GetUpdateSize(usz size) const noexcept
+            {
+                return (pending_count + size) / 3 * 4;
+            }
+
+            usz Update(void* output, const void* input, usz size)
+            {
+                char* encoded = reinterpret_cast<char*>(output);
+                const u8* data = reinterpret_cast<const u8*>(input);
+                usz written = 0;
+
+                if (pending_count) {
+                    while (pending_count < 3 && size > 0) {
+                        pending[pending_count++] = *data++;
+                        size--;
+                    }
+                    if (pending_count < 3) {
+                        return 0;
+                    }
+                    written += Encode(encoded, 4, pending, 3, false, *table);
+                    pending_count = 0;
+                }
+
+                usz bulk = size / 3 * 3;
+                written += Encode(encoded + written, EncodedSize(bulk), data, bulk, false, *table);
+
+                for (usz i = bulk; i < size; ++i) {
+                    pending[pending_count++] = data[i];
+                }
+
+                return written;
+            }
+
+            usz GetFinishSize() const noexcept
+            {
+                return EncodedSize(pending_count, pad);
+            }
+
+            // Flushes carried over bytes and padding, the encoder can then be reused for a new stream
+            usz Finish(void* output)
+            {
+                usz written = Encode(output, 4, pending, pending_count, pad, *table);
+                pending_count = 0;
+                return written;
+            }
+
+            void Update(std::string& output, Span<b8> bytes)
+            {
+                usz offset = output.size();
+                output.resize(offset + GetUpdateSize(bytes.size()));
+                Update(output.data() + offset, bytes.data(), bytes.size());
+            }
+
+            void Finish(std::string& output)
+            {
+                usz offset = output.size();
+                output.resize(offset + GetFinishSize());
+                Finish(output.data() + offset);
+            }
+        };
+
+        // Incremental decoder, the counterpart to Encoder. The last characters seen are always held back until more
+        // input arrives or Finish is called, since only the final quad may contain padding. Input is expected to be
+        // a contiguous run of base64 characters without line breaks or other whitespace
+        class Decoder
+        {
+            const Table* table;
+
+            char pending[4] = {};
+            u32  pending_count = 0;
+
+        public:
+            static constexpr usz MaxFinishSize = 3;
+
+            explicit Decoder(const Table& _table = tables::Default)
+                : table(&_table)
+            {}
+
+            // Upper bound on the number of bytes the next Update(size) will write
+            usz GetUpdateSize(usz size) const noexcept
+            {
+                return (pending_count + size) / 4 * 3;
+            }
+
+            usz Update(void* output, const void* input, usz size)
+            {
+                u8* data = reinterpret_cast<u8*>(output);
+                const char* encoded = reinterpret_cast<const char*>(input);
+                usz written = 0;
+
+                if (size == 0) {
+                    return 0;
+                }
+
+                if (pending_count) {
+                    while (pending_count < 4 && size > 0) {
+                        pending[pending_count++] = *encoded++;
+                        size--;
+                    }
+                    if (pending_count < 4 || size == 0) {
+                        return 0;
+                    }
+                    written += DecodeQuads(data, pending, 4);
+                    pending_count = 0;
+                }
+
+                // Hold back at least one character so that a trailing padded quad is only seen by Finish
+                usz bulk = (size - 1) / 4 * 4;
+                written += DecodeQuads(data + written, encoded, bulk);
+
+                for (usz i = bulk; i < size; ++i) {
+                    pending[pending_count++] = encoded[i];
+                }
+
+                return written;
+            }
+
+            // Decodes the held back characters, the decoder can then be reused for a new stream
+            usz Finish(void* output)
+            {
+                usz written = Decode(output, MaxFinishSize, pending, pending_count, *table);
+                pending_count = 0;
+                return written;
+            }
+
+            void Update(std::vector<b8>& output, std::string_view encoded)
+            {
+                usz offset = output.size();
+                output.resize(offset + GetUpdateSize(encoded.size()));
+                output.resize(offset + Update(output.data() + offset, encoded.data(), encoded.size()));
+            }
+
+            void Finish(std::vector<b8>& output)
+            {
+                usz offset = output.size();
+                output.resize(offset + MaxFinishSize);
+                output.resize(offset + Finish(output.data() + offset));
+            }
+
+        private:
+            usz DecodeQuads(u8* data, const char* encoded, usz size)
+            {
+                if (size > 0 && table->decode[u8(encoded[size - 1])] == Padding) {
+                    NOVA_THROW("Unexpected base64 padding before end of stream");
+                }
+                return Decode(data, size / 4 * 3, encoded, size, *table);
+            }
+        };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "Core.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                           Concurrent Hash Map
+// -----------------------------------------------------------------------------
+
+    // Insert-only hash map for read-mostly caches shared between threads.
+    //
+    // Keys are spread over lock-striped shards, each an open addressed table of atomic node pointers. Lookups never
+    // take a lock: they load the current table of a shard and probe it with acquire loads, which is wait-free since
+    // tables are kept at most half full. Writers serialize per shard, and growing a table publishes a rehashed copy
+    // while retired tables are kept alive until the map is cleared, so a reader racing a resize at worst misses a
+    // key that was just inserted.
+    //
+    // Nodes are never moved or freed while the map is live, so references to values stay valid. GetOrCreate runs
+    // the creator outside of any lock and exactly once per key, concurrent callers for the same key block until
+    // the value is ready. If the creator throws the key is left empty and the next caller retries.
+
+    template<typename K, typename V, typename Hash = ankerl::unordered_dense::hash<K>, u32 ShardBits = 6>
+    class ConcurrentHashMap
+    {
+        static constexpr u32 ShardCount = 1u << ShardBits;
+        static constexpr usz InitialCapacity = 16;
+
+        enum : u32
+        {
+            Empty,
+            Pending,
+            Ready,
+        };
+
+        struct Node
+        {
+            K                         key;
+            u64                      hash;
+            std::atomic<u32> state = Empty;
+            alignas(V) std::byte storage[sizeof(V)];
+
+            V* Value() noexcept { return std::launder(reinterpret_cast<V*>(storage)); }
+        };
+
+        struct Table
+        {
+            usz                                      mask;
+            std::unique_ptr<std::atomic<Node*>[]> slots;
+
+            explicit Table(usz capacity)
+                : mask(capacity - 1)
+                , slots(new std::atomic<Node*>[capacity]{})
+            {}
+        };
+
+        struct alignas(64) Shard
+        {
+            std::atomic<Table*>           table = nullptr;
+            std::atomic<usz>         ready_count = 0;
+            std::mutex                      mutex;
+            std::vector<std::unique_ptr<Table>> tables; // Current table last, retired tables before it
+            usz                             count = 0;
+        };
+
+        std::unique_ptr<Shard[]> shards{ new Shard[ShardCount] };
+
+    public:
+        ConcurrentHashMap() = default;
+
+        ~ConcurrentHashMap()
+        {
+            Clear();
+        }
+
+        ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+        ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        // Returns the value for key if it has been created, wait-free
+        V* Find(const K& key) const noexcept
+        {
+            u64 hash = Hash{}(key);
+            Node* node = FindNode(GetShard(hash).table.load(std::memory_order::acquire), key, hash);
+            return node && node->state.load(std::memory_order::acquire) == Ready ? node->Value() : nullptr;
+        }
+
+        // Returns the value for key, invoking create() to produce it if this is the first request for the key
+        template<typename Fn>
+        V& GetOrCreate(const K& key, Fn&& create)
+        {
+            u64 hash = Hash{}(key);
+            Shard& shard = GetShard(hash);
+
+            Node* node = FindNode(shard.table.load(std::memory_order::acquire), key, hash);
+            if (!node) [[unlikely]] {
+                node = InsertNode(shard, key, hash);
+            }
+
+            for (;;) {
+                u32 state = node->state.load(std::memory_order::acquire);
+                if (state == Ready) [[likely]] {
+                    return *node->Value();
+                }
+
+                if (state == Pending) {
+                    node->state.wait(Pending, std::memory_order::acquire);
+                    continue;
+                }
+
+                if (!node->state.compare_exchange_strong(state, Pending, std::memory_order::acquire)) {
+                    continue;
+                }
+
+                try {
+                    new (node->storage) V(create());
+                } catch (...) {
+                    node->state.store(Empty, std::memory_order::release);
+                    node->state.notify_all();
+                    throw;
+                }
+
+                shard.ready_count.fetch_add(1, std::memory_order::relaxed);
+                node->state.store(Ready, std::memory_order::release);
+                node->state.notify_all();
+                return *node->Value();
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        // Visits every created value as fn(const K&, V&). Must not run concurrently with insertion
+        template<typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (u32 i = 0; i < ShardCount; ++i) {
+                Table* table = shards[i].table.load(std::memory_order::acquire);
+                if (!table) {
+                    continue;
+                }
+
+                for (usz s = 0; s <= table->mask; ++s) {
+                    Node* node = table->slots[s].load(std::memory_order::acquire);
+                    if (node && node->state.load(std::memory_order::acquire) == Ready) {
+                        fn(std::as_const(node->key), *node->Value());
+                    }
+                }
+            }
+        }
+
+        // Number of created values
+        usz Size() const noexcept
+        {
+            usz size = 0;
+            for (u32 i = 0; i < ShardCount; ++i) {
+                size += shards[i].ready_count.load(std::memory_order::relaxed);
+            }
+            return size;
+        }
+
+        // Destroys all values and frees all tables. Not thread safe
+        void Clear()
+        {
+            for (u32 i = 0; i < ShardCount; ++i) {
+                Shard& shard = shards[i];
+                if (Table* table = shard.table.load(std::memory_order::relaxed)) {
+                    for (usz s = 0; s <= table->mask; ++s) {
+                        if (Node* node = table->slots[s].load(std::memory_order::relaxed)) {
+                            if (node->state.load(std::memory_order::relaxed) == Ready) {
+                                node->Value()->~V();
+                            }
+                            delete node;
+                        }
+                    }
+                }
+                shard.table.store(nullptr, std::memory_order::relaxed);
+                shard.tables.clear();
+                shard.ready_count.store(0, std::memory_order::relaxed);
+                shard.count = 0;
+            }
+        }
+
+    private:
+        Shard& GetShard(u64 hash) const noexcept
+        {
+            return shards[hash >> (64 - ShardBits)];
+        }
+
+        static Node* FindNode(Table* table, const K& key, u64 hash) noexcept
+        {
+            if (!table) {
+                return nullptr;
+            }
+
+            for (usz i = hash & table->mask;; i = (i + 1) & table->mask) {
+                Node* node = table->slots[i].load(std::memory_order::acquire);
+                if (!node || (node->hash == hash && node->key == key)) {
+                    return node;
+                }
+            }
+        }
+
+        static void Place(Table& table, Node* node) noexcept
+        {
+            usz i = node->hash & table.mask;
+            while (table.slots[i].load(std::memory_order::relaxed)) {
+                i = (i + 1) & table.mask;
+            }
+            table.slots[i].store(node, std::memory_order::release);
+        }
+
+        NOVA_NO_INLINE
+        Node* InsertNode(Shard& shard, const K& key, u64 hash)
+        {
+            std::scoped_lock lock{ shard.mutex };
+
+            // Another writer may have inserted the key since the lock free lookup
+            Table* table = shard.table.load(std::memory_order::relaxed);
+            if (Node* node = FindNode(table, key, hash)) {
+                return node;
+            }
+
+            if (!table || (shard.count + 1) * 2 > table->mask + 1) {
+                auto& grown = shard.tables.emplace_back(new Table(table ? (table->mask + 1) * 2 : InitialCapacity));
+                if (table) {
+                    for (usz s = 0; s <= table->mask; ++s) {
+                        if (Node* node = table->slots[s].load(std::memory_order::relaxed)) {
+                            Place(*grown, node);
+                        }
+                    }
+                }
+                table = grown.get();
+                shard.table.store(table, std::memory_order::release);
+            }
+
+            Node* node = new Node{ .key = key, .hash = hash };
+            Place(*table, node);
+            shard.count++;
+            return node;
+        }
+    };
+}
@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <deque>
 #include <execution>
+#include <format>
 #include <fstream>
 #include <functional>
 #include <initializer_list>
@@ -113,6 +114,7 @@ namespace nova
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <fmt/chrono.h>
 
 #pragma warning(pop)
 
@@ -766,7 +768,8 @@ namespace nova
     };
     NOVA_DECORATE_FLAG_ENUM(FreeType)
 
-    void* AllocVirtual(AllocationType type, usz size);
+    // Reserves and/or commits a range. Commit with a non-null address commits pages within a previously reserved range
+    void* AllocVirtual(AllocationType type, usz size, void* address = nullptr);
     void FreeVirtual(FreeType type, void* ptr, usz size = 0);
 
     inline
@@ -786,6 +789,15 @@ namespace nova
     {
         mi_free(ptr);
     }
+
+    // Lazily constructed instance of T that is never destroyed. For process-wide state that static destructors, or
+    // threads exiting during shutdown, may still use after static destruction has begun
+    template<typename T>
+    T& LeakedInstance()
+    {
+        static T* instance = new T;
+        return *instance;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -815,14 +827,139 @@ namespace nova
     struct FunctionRef : GetFunctionImpl<Sig>::type {
         template<typename Fn>
         FunctionRef(Fn&& fn)
-            : GetFunctionImpl<Sig>::type(&fn,
-                []<typename... Args>(void*b, Args&&... args) -> auto {
-                    return std::forward<Fn>(*static_cast<Fn*>(b))(std::forward<Args>(args)...);
+            : GetFunctionImpl<Sig>::type(const_cast<void*>(static_cast<const void*>(std::addressof(fn))),
+                []<typename... Args>(void*b, Args... args) -> auto {
+                    return std::forward<Fn>(*static_cast<std::remove_reference_t<Fn>*>(b))(std::forward<Args>(args)...);
                 })
         {};
     };
 }
 
+// -----------------------------------------------------------------------------
+//                          Type erased owning functor
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Move-only owning callable. Functors that fit in InlineSize bytes and are nothrow movable are stored inline,
+    // anything larger is heap allocated. Unlike std::function this does not require the functor to be copyable and
+    // does not depend on RTTI.
+
+    template<typename Sig, usz InlineSize = 48>
+    class Function;
+
+    template<typename Ret, typename... Args, usz InlineSize>
+    class Function<Ret(Args...), InlineSize>
+    {
+        struct Operations
+        {
+            Ret(*invoke)(void* storage, Args&&... args);
+            void(*relocate)(void* dst, void* src) noexcept;
+            void(*destroy)(void* storage) noexcept;
+        };
+
+        template<typename Fn>
+        static constexpr bool StoredInline = sizeof(Fn) <= InlineSize
+            && alignof(Fn) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Fn>;
+
+        template<typename Fn>
+        static constexpr Operations InlineOperations {
+            .invoke = [](void* storage, Args&&... args) -> Ret {
+                return std::invoke_r<Ret>(*static_cast<Fn*>(storage), std::forward<Args>(args)...);
+            },
+            .relocate = [](void* dst, void* src) noexcept {
+                new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            },
+            .destroy = [](void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); },
+        };
+
+        template<typename Fn>
+        static constexpr Operations HeapOperations {
+            .invoke = [](void* storage, Args&&... args) -> Ret {
+                return std::invoke_r<Ret>(**static_cast<Fn**>(storage), std::forward<Args>(args)...);
+            },
+            .relocate = [](void* dst, void* src) noexcept { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); },
+            .destroy = [](void* storage) noexcept { delete *static_cast<Fn**>(storage); },
+        };
+
+        static_assert(InlineSize >= sizeof(void*), "Function inline storage must fit a heap pointer");
+
+        alignas(std::max_align_t) std::byte storage[InlineSize];
+        const Operations*                 operations = nullptr;
+
+    public:
+        // True if a callable of type Fn is stored without allocating
+        template<typename Fn>
+        static constexpr bool FitsInline = StoredInline<std::decay_t<Fn>>;
+
+        Function() = default;
+        Function(std::nullptr_t) noexcept {}
+
+        template<typename Fn>
+            requires (!std::same_as<std::remove_cvref_t<Fn>, Function>)
+                && std::is_invocable_r_v<Ret, std::decay_t<Fn>&, Args...>
+        Function(Fn&& fn)
+        {
+            using F = std::decay_t<Fn>;
+            if constexpr (StoredInline<F>) {
+                new (storage) F(std::forward<Fn>(fn));
+                operations = &InlineOperations<F>;
+            } else {
+                *reinterpret_cast<F**>(storage) = new F(std::forward<Fn>(fn));
+                operations = &HeapOperations<F>;
+            }
+        }
+
+        Function(Function&& other) noexcept
+            : operations(std::exchange(other.operations, nullptr))
+        {
+            if (operations) {
+                operations->relocate(storage, other.storage);
+            }
+        }
+
+        Function& operator=(Function&& other) noexcept
+        {
+            if (this != &other) {
+                Reset();
+                operations = std::exchange(other.operations, nullptr);
+                if (operations) {
+                    operations->relocate(storage, other.storage);
+                }
+            }
+            return *this;
+        }
+
+        Function(const Function&) = delete;
+        Function& operator=(const Function&) = delete;
+
+        ~Function()
+        {
+            Reset();
+        }
+
+        void Reset() noexcept
+        {
+            if (operations) {
+                operations->destroy(storage);
+                operations = nullptr;
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return operations;
+        }
+
+        Ret operator()(Args... args)
+        {
+            return operations->invoke(storage, std::forward<Args>(args)...);
+        }
+    };
+}
+
 // -----------------------------------------------------------------------------
 //                                  Span
 // -----------------------------------------------------------------------------
@@ -928,19 +1065,23 @@ namespace nova
         struct Impl;
 
     protected:
-        Impl* impl = {};
+        Impl*        impl = {};
+
+        // Generation of the pool slot the Impl was acquired from, or 0 for objects that are not pooled. Lets a
+        // pool reject a handle whose object was destroyed even if the slot has since been reused
+        u32    generation = 0;
 
     public:
         Handle() = default;
-        Handle(Impl* _impl): impl(_impl) {};
+        Handle(Impl* _impl, u32 _generation = 0): impl(_impl), generation(_generation) {};
 
-        operator T() const noexcept { return T(impl); }
-        T   Unwrap() const noexcept { return T(impl); }
+        operator T() const noexcept { return Unwrap(); }
+        T   Unwrap() const noexcept { T t(impl); t.generation = generation; return t; }
 
         operator   bool() const noexcept { return impl; }
         auto operator->() const noexcept { return impl; }
 
-        bool operator==(Handle other) const noexcept { return impl == other.impl; }
+        bool operator==(Handle other) const noexcept { return impl == other.impl && generation == other.generation; }
     };
 }
 
@@ -1016,6 +1157,87 @@ namespace nova::hash
     }
 }
 
+// -----------------------------------------------------------------------------
+//                          Incrementally Hashed Key
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Memory compared key that carries its own hash, so hash map lookups never rehash the whole key.
+    //
+    // The hash is a sum with one term per member, each the hash of the member's bytes mixed with its offset, taken
+    // relative to the all-zero key. Changing a member through Set subtracts its old term and adds the new one, so
+    // only the bytes of that member are rehashed. Members must only be written through Set.
+
+    template<typename T>
+    class HashedKey
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "HashedKey requires a trivially copyable key");
+
+        T      key;
+        u64 hash = 0;
+
+    public:
+        HashedKey() noexcept
+        {
+            // Padding bytes take part in comparisons, so the key must start out fully zeroed
+            std::memset(&key, 0, sizeof(key));
+        }
+
+        // Returns true if the member changed
+        template<typename M>
+        bool Set(M T::* member, const M& value) noexcept
+        {
+            M& field = key.*member;
+            if (std::memcmp(&field, &value, sizeof(M)) == 0) {
+                return false;
+            }
+
+            usz offset = usz(reinterpret_cast<const std::byte*>(&field) - reinterpret_cast<const std::byte*>(&key));
+            hash -= Term(offset, field);
+            std::memcpy(&field, &value, sizeof(M));
+            hash += Term(offset, field);
+            return true;
+        }
+
+        const T& Get() const noexcept
+        {
+            return key;
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &key;
+        }
+
+        u64 Hash() const noexcept
+        {
+            return hash;
+        }
+
+        bool operator==(const HashedKey& other) const noexcept
+        {
+            return hash == other.hash && std::memcmp(&key, &other.key, sizeof(T)) == 0;
+        }
+
+    private:
+        template<typename M>
+        static u64 Term(usz offset, const M& value) noexcept
+        {
+            return nova::hash::Mix(nova::hash::Hash(&value, sizeof(M)), 0x9e37'79b9'7f4a'7c15ull * (offset + 1));
+        }
+    };
+}
+
+template<typename T>
+struct ankerl::unordered_dense::hash<nova::HashedKey<T>>
+{
+    using is_avalanching = void;
+    uint64_t operator()(const nova::HashedKey<T>& key) const noexcept {
+        return key.Hash();
+    }
+};
+
 // -----------------------------------------------------------------------------
 //                            CString + StringView
 // -----------------------------------------------------------------------------
@@ -1080,7 +1302,6 @@ namespace nova
 // -----------------------------------------------------------------------------
 
     // TODO: Hashing, comparison, etc..
-    // TODO: One String class to rule them all with COW semantics?
 
     template<typename CharT>
     class BasicStringView
@@ -1171,126 +1392,1512 @@ namespace nova
             , length(u64(Size))
             , null_terminated(false)
         {
-            FixIfLastIsNull();
+            FixIfLastIsNull();
+        }
+
+// -----------------------------------------------------------------------------
+
+        constexpr bool IsNullTerminated() const noexcept
+        {
+            return null_terminated;
+        }
+
+        constexpr usz Size() const noexcept
+        {
+            return length;
+        }
+
+        constexpr const CharT* begin() const noexcept
+        {
+            return data;
+        }
+
+        constexpr const CharT* end() const noexcept
+        {
+            return data + length;
+        }
+
+        constexpr const CharT* Data() const noexcept
+        {
+            return data;
+        }
+
+        constexpr CString<CharT> CStr() const
+        {
+            return CString<CharT>(data, length, null_terminated);
+        }
+
+// -----------------------------------------------------------------------------
+
+        constexpr explicit operator std::basic_string<CharT>() const
+        {
+            return std::basic_string<CharT>(data, length);
+        }
+
+        constexpr operator std::basic_string_view<CharT>() const noexcept
+        {
+            return std::basic_string_view<CharT>(data, length);
+        }
+
+        constexpr operator fs::path() const noexcept
+        {
+            return fs::path(std::basic_string_view<CharT>(*this));
+        }
+
+// -----------------------------------------------------------------------------
+
+        constexpr bool operator==(const BasicStringView& other) const noexcept
+        {
+            if (length != other.length) return false;
+            return std::memcmp(data, other.data, length) == 0;
+        }
+    };
+
+    template<typename CharT>
+    std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicStringView<CharT>& str)
+    {
+        return os << std::basic_string_view<CharT>(str);
+    }
+
+    using StringView = BasicStringView<char>;
+}
+
+namespace fmt
+{
+    template<typename CharT>
+    struct formatter<::nova::BasicStringView<CharT>> : ostream_formatter {};
+}
+
+// -----------------------------------------------------------------------------
+//                                  String
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Immutable-by-default string with value semantics.
+    //
+    // Strings of up to InlineCapacity characters are stored inline. Longer strings live in a reference counted
+    // block that copies share, and which is only duplicated when a shared string is modified (copy on write).
+    //
+    // Intern() returns the canonical copy of a string from a global table. Interned blocks are never freed, so
+    // copying an interned string does not touch a reference count, and two interned strings are equal exactly when
+    // they share a block, which makes comparison and hashing O(1). Strings are always null terminated.
+
+    class String
+    {
+        struct Block
+        {
+            std::atomic<u32> ref_count;
+            bool              interned;
+            usz                 length;
+            usz               capacity;
+            u64                   hash; // Only computed for interned blocks
+            char               data[1];
+        };
+
+        static constexpr u8 HeapTag = 0xFF;
+
+    public:
+        static constexpr usz InlineCapacity = 22;
+
+    private:
+        union
+        {
+            char   chars[InlineCapacity + 1] = {};
+            Block* block;
+        };
+        u8 inline_size = 0;
+
+    public:
+        String() noexcept = default;
+
+        explicit String(std::string_view str)
+        {
+            if (str.size() <= InlineCapacity) {
+                std::memcpy(chars, str.data(), str.size());
+                chars[str.size()] = '\0';
+                inline_size = u8(str.size());
+            } else {
+                block = AllocateBlock(str, str.size());
+                inline_size = HeapTag;
+            }
+        }
+
+        explicit String(StringView str)
+            : String(std::string_view(str))
+        {}
+
+        explicit String(const char* str)
+            : String(std::string_view(str))
+        {}
+
+        explicit String(const std::string& str)
+            : String(std::string_view(str))
+        {}
+
+        String(const String& other) noexcept
+            : inline_size(other.inline_size)
+        {
+            std::memcpy(chars, other.chars, sizeof(chars));
+            if (IsHeap()) {
+                Acquire(block);
+            }
+        }
+
+        String& operator=(const String& other) noexcept
+        {
+            if (this != &other) {
+                this->~String();
+                new (this) String(other);
+            }
+            return *this;
+        }
+
+        String(String&& other) noexcept
+            : inline_size(std::exchange(other.inline_size, 0))
+        {
+            std::memcpy(chars, other.chars, sizeof(chars));
+            other.chars[0] = '\0';
+        }
+
+        String& operator=(String&& other) noexcept
+        {
+            if (this != &other) {
+                this->~String();
+                new (this) String(std::move(other));
+            }
+            return *this;
+        }
+
+        ~String()
+        {
+            if (IsHeap()) {
+                Release(block);
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        // Returns the canonical interned copy of the string
+        static String Intern(std::string_view str)
+        {
+            auto& table = GetInternTable();
+            u64 hash = ankerl::unordered_dense::hash<std::string_view>{}(str);
+
+            String interned;
+            interned.inline_size = HeapTag;
+            {
+                std::scoped_lock lock{ table.mutex };
+                auto iter = table.blocks.find(str);
+                if (iter == table.blocks.end()) {
+                    Block* created = AllocateBlock(str, str.size());
+                    created->interned = true;
+                    created->hash = hash;
+                    // Keyed by the block's own characters, the caller's string may not outlive the table
+                    iter = table.blocks.emplace(std::string_view(created->data, created->length), created).first;
+                }
+                interned.block = iter->second;
+            }
+            return interned;
+        }
+
+        static String Intern(StringView str)
+        {
+            return Intern(std::string_view(str));
+        }
+
+        static String Intern(const char* str)
+        {
+            return Intern(std::string_view(str));
+        }
+
+        static String Intern(const std::string& str)
+        {
+            return Intern(std::string_view(str));
+        }
+
+// -----------------------------------------------------------------------------
+
+        // Appends to the string, copying first if the storage is shared or interned
+        String& Append(std::string_view str)
+        {
+            usz size = Size();
+            usz new_size = size + str.size();
+
+            if (!IsHeap() && new_size <= InlineCapacity) {
+                std::memcpy(chars + size, str.data(), str.size());
+                chars[new_size] = '\0';
+                inline_size = u8(new_size);
+                return *this;
+            }
+
+            bool in_place = IsHeap() && !block->interned
+                && block->ref_count.load(std::memory_order::acquire) == 1 && new_size <= block->capacity;
+            Block* target = in_place ? block : AllocateBlock(View(), std::max(new_size, size * 2));
+
+            // str may point into our own storage, so finish copying before the old storage is released or overwritten
+            std::memcpy(target->data + size, str.data(), str.size());
+            target->data[new_size] = '\0';
+            target->length = new_size;
+
+            if (!in_place) {
+                if (IsHeap()) {
+                    Release(block);
+                }
+                block = target;
+                inline_size = HeapTag;
+            }
+            return *this;
+        }
+
+        String& operator+=(std::string_view str)
+        {
+            return Append(str);
+        }
+
+        void Clear() noexcept
+        {
+            this->~String();
+            new (this) String();
+        }
+
+// -----------------------------------------------------------------------------
+
+        usz Size() const noexcept
+        {
+            return IsHeap() ? block->length : inline_size;
+        }
+
+        bool Empty() const noexcept
+        {
+            return Size() == 0;
+        }
+
+        const char* Data() const noexcept
+        {
+            return IsHeap() ? block->data : chars;
+        }
+
+        const char* CStr() const noexcept
+        {
+            return Data();
+        }
+
+        const char* begin() const noexcept
+        {
+            return Data();
+        }
+
+        const char* end() const noexcept
+        {
+            return Data() + Size();
+        }
+
+        std::string_view View() const noexcept
+        {
+            return { Data(), Size() };
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return View();
+        }
+
+        bool IsInterned() const noexcept
+        {
+            return IsHeap() && block->interned;
+        }
+
+        u64 Hash() const noexcept
+        {
+            return IsInterned() ? block->hash : ankerl::unordered_dense::hash<std::string_view>{}(View());
+        }
+
+// -----------------------------------------------------------------------------
+
+        friend bool operator==(const String& l, const String& r) noexcept
+        {
+            if (l.IsHeap() && r.IsHeap()) {
+                if (l.block == r.block) return true;
+                if (l.block->interned && r.block->interned) return false;
+            }
+            return l.View() == r.View();
+        }
+
+        friend bool operator==(const String& l, std::string_view r) noexcept
+        {
+            return l.View() == r;
+        }
+
+        friend auto operator<=>(const String& l, const String& r) noexcept
+        {
+            return l.View() <=> r.View();
+        }
+
+    private:
+        bool IsHeap() const noexcept
+        {
+            return inline_size == HeapTag;
+        }
+
+        static Block* AllocateBlock(std::string_view str, usz capacity)
+        {
+            auto* created = static_cast<Block*>(Alloc(offsetof(Block, data) + capacity + 1, alignof(Block)));
+            new (created) Block {
+                .ref_count = 1,
+                .interned = false,
+                .length = str.size(),
+                .capacity = capacity,
+                .hash = 0,
+            };
+            std::memcpy(created->data, str.data(), str.size());
+            created->data[str.size()] = '\0';
+            return created;
+        }
+
+        static void Acquire(Block* shared) noexcept
+        {
+            if (!shared->interned) {
+                shared->ref_count.fetch_add(1, std::memory_order::relaxed);
+            }
+        }
+
+        static void Release(Block* shared) noexcept
+        {
+            if (!shared->interned && shared->ref_count.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+                shared->~Block();
+                Free(shared);
+            }
+        }
+
+        struct InternTable
+        {
+            std::mutex                                            mutex;
+            ankerl::unordered_dense::map<std::string_view, Block*> blocks;
+        };
+
+        static InternTable& GetInternTable()
+        {
+            return LeakedInstance<InternTable>();
+        }
+    };
+}
+
+template<>
+struct ankerl::unordered_dense::hash<nova::String>
+{
+    using is_avalanching = void;
+    using is_transparent = void;
+
+    uint64_t operator()(const nova::String& str) const noexcept {
+        return str.Hash();
+    }
+
+    uint64_t operator()(std::string_view str) const noexcept {
+        return ankerl::unordered_dense::hash<std::string_view>{}(str);
+    }
+};
+
+template<>
+struct std::hash<nova::String>
+{
+    size_t operator()(const nova::String& str) const noexcept {
+        return size_t(str.Hash());
+    }
+};
+
+template<>
+struct fmt::formatter<nova::String> : fmt::formatter<std::string_view>
+{
+    auto format(const nova::String& str, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(str.View(), ctx);
+    }
+};
+
+template<>
+struct std::formatter<nova::String> : std::formatter<std::string_view>
+{
+    auto format(const nova::String& str, std::format_context& ctx) const {
+        return std::formatter<std::string_view>::format(str.View(), ctx);
+    }
+};
+
+// -----------------------------------------------------------------------------
+//                               Formatting
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    inline
+    std::string Fmt(StringView str)
+    {
+        return std::string(str);
+    }
+
+    template<typename ...Args>
+    std::string Fmt(const fmt::format_string<Args...> fmt, Args&&... args)
+    {
+        return fmt::vformat(fmt.get(), fmt::make_format_args(args...));
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                                 Logging
+// -----------------------------------------------------------------------------
+
+// Levels below NOVA_LOG_LEVEL are compiled out entirely, their arguments are never evaluated
+#ifndef NOVA_LOG_LEVEL
+#  ifdef NDEBUG
+#    define NOVA_LOG_LEVEL 1
+#  else
+#    define NOVA_LOG_LEVEL 0
+#  endif
+#endif
+
+// Leveled log macros capture the raw bytes of supported arguments and defer formatting to the logging thread
+#ifndef NOVA_LOG_DEFERRED
+#  define NOVA_LOG_DEFERRED 1
+#endif
+
+namespace nova
+{
+    enum class LogLevel : u8
+    {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Off,
+    };
+
+    // Argument kinds that can be captured as raw bytes and formatted later
+    enum class LogArgType : u8
+    {
+        Bool,
+        Char,
+        I64,
+        U64,
+        F32,
+        F64,
+        String,
+        Pointer,
+    };
+
+    // Static description of a deferred log call site, one per LogTrace..LogError invocation
+    struct LogSite
+    {
+        LogLevel             level;
+        const char*         format;
+        const char*           file;
+        u32                   line;
+        u32              arg_count;
+        const LogArgType* arg_types;
+    };
+
+    struct LogMessage
+    {
+        LogLevel                    level;
+        bool                       tagged; // False for plain Log() output, which is printed without a level tag
+        chr::system_clock::time_point time;
+        StringView                   text;
+
+        // Set for deferred messages, the raw arguments in the encoding described by site->arg_types.
+        // text is only formatted when at least one sink needs it.
+        const LogSite*     site = nullptr;
+        Span<std::byte> payload;
+    };
+
+    // Sinks are invoked from the logging thread, with all messages that were ready at the time in a single batch.
+    // After shutdown (atexit, crash handlers) messages are instead written one at a time on the logging caller
+
+    struct LogSink
+    {
+        virtual ~LogSink() = default;
+
+        virtual void Write(Span<LogMessage> messages) = 0;
+
+        // Sinks that only consume the raw payload of deferred messages can skip formatting entirely
+        virtual bool NeedsText() const { return true; }
+    };
+
+    class ConsoleLogSink : public LogSink
+    {
+        fmt::memory_buffer buffer;
+
+    public:
+        void Write(Span<LogMessage> messages) override
+        {
+            for (auto& message : messages) {
+                std::string_view text = message.text;
+
+                if (!message.tagged) {
+                    fmt::format_to(std::back_inserter(buffer), "{}\n", text);
+                    continue;
+                }
+
+                switch (message.level) {
+                    break;case LogLevel::Trace: fmt::format_to(std::back_inserter(buffer), "[\u001B[90mTRACE\u001B[0m] \u001B[90m{}\u001B[0m\n", text);
+                    break;case LogLevel::Debug: fmt::format_to(std::back_inserter(buffer), "[\u001B[96mDEBUG\u001B[0m] {}\u001B[0m\n", text);
+                    break;case LogLevel::Info:  fmt::format_to(std::back_inserter(buffer), "[\u001B[94mINFO\u001B[0m] {}\u001B[0m\n", text);
+                    break;case LogLevel::Warn:  fmt::format_to(std::back_inserter(buffer), "[\u001B[93mWARN\u001B[0m] {}\u001B[0m\n", text);
+                    break;default:              fmt::format_to(std::back_inserter(buffer), "[\u001B[91mERROR\u001B[0m] {}\u001B[0m\n", text);
+                }
+            }
+
+            std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+            std::fflush(stdout);
+            buffer.clear();
+        }
+    };
+
+    class FileLogSink : public LogSink
+    {
+        std::ofstream        file;
+        fmt::memory_buffer buffer;
+
+    public:
+        FileLogSink(const std::filesystem::path& path, bool append = false)
+            : file(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc))
+        {
+            if (!file) {
+                // Exceptions are defined after logging, as they log on construction
+                throw std::runtime_error(fmt::format("Failed to open log file: {}", path.string()));
+            }
+        }
+
+        void Write(Span<LogMessage> messages) override
+        {
+            static constexpr std::array<const char*, 5> Tags { "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+
+            for (auto& message : messages) {
+                auto time = chr::floor<chr::milliseconds>(message.time);
+                std::string_view text = message.text;
+                if (message.tagged) {
+                    fmt::format_to(std::back_inserter(buffer), "{:%Y-%m-%d %H:%M:%S} [{}] {}\n", time, Tags[std::min(u32(message.level), 4u)], text);
+                } else {
+                    fmt::format_to(std::back_inserter(buffer), "{:%Y-%m-%d %H:%M:%S} {}\n", time, text);
+                }
+            }
+
+            file.write(buffer.data(), std::streamsize(buffer.size()));
+            file.flush();
+            buffer.clear();
+        }
+    };
+
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        template<typename T>
+        consteval std::optional<LogArgType> GetLogArgType()
+        {
+            using D = std::remove_cvref_t<T>;
+            if constexpr (std::same_as<D, bool>)                          return LogArgType::Bool;
+            else if constexpr (std::same_as<D, char>)                     return LogArgType::Char;
+            else if constexpr (std::same_as<D, f32>)                      return LogArgType::F32;
+            else if constexpr (std::same_as<D, f64>)                      return LogArgType::F64;
+            else if constexpr (std::signed_integral<D>)                   return LogArgType::I64;
+            else if constexpr (std::unsigned_integral<D>)                 return LogArgType::U64;
+            else if constexpr (std::convertible_to<const D&, std::string_view>) return LogArgType::String;
+            else if constexpr (std::is_pointer_v<D>)                      return LogArgType::Pointer;
+            else                                                          return std::nullopt;
+        }
+
+        template<typename... Args>
+        concept LogDeferrable = (GetLogArgType<Args>().has_value() && ...);
+
+        template<typename... Args>
+        inline constexpr std::array<LogArgType, sizeof...(Args)> LogArgTypes { *GetLogArgType<Args>()... };
+
+        // Strings are encoded as a u32 length followed by the bytes, everything else as 8 (or 4 for f32) raw bytes
+
+        template<typename T>
+        usz LogArgSize(const T& arg) noexcept
+        {
+            constexpr auto Type = *GetLogArgType<T>();
+            if constexpr (Type == LogArgType::String) return sizeof(u32) + std::string_view(arg).size();
+            else if constexpr (Type == LogArgType::F32) return sizeof(f32);
+            else return sizeof(u64);
+        }
+
+        template<typename T>
+        std::byte* EncodeLogArg(std::byte* out, const T& arg) noexcept
+        {
+            constexpr auto Type = *GetLogArgType<T>();
+            if constexpr (Type == LogArgType::String) {
+                std::string_view str = arg;
+                u32 size = u32(str.size());
+                std::memcpy(out, &size, sizeof(size));
+                std::memcpy(out + sizeof(size), str.data(), size);
+                return out + sizeof(size) + size;
+            } else if constexpr (Type == LogArgType::F32) {
+                std::memcpy(out, &arg, sizeof(f32));
+                return out + sizeof(f32);
+            } else {
+                u64 bits;
+                if constexpr (Type == LogArgType::F64)          bits = std::bit_cast<u64>(arg);
+                else if constexpr (Type == LogArgType::Pointer) bits = u64(uintptr_t(arg));
+                else if constexpr (Type == LogArgType::I64)     bits = u64(i64(arg));
+                else                                            bits = u64(arg);
+                std::memcpy(out, &bits, sizeof(bits));
+                return out + sizeof(bits);
+            }
+        }
+
+        // Formats a deferred message, used by the logging thread and when reading binary logs
+        inline
+        void FormatLogRecord(fmt::memory_buffer& out, const LogSite& site, Span<std::byte> payload)
+        {
+            fmt::dynamic_format_arg_store<fmt::format_context> store;
+            store.reserve(site.arg_count, 0);
+
+            const std::byte* in = payload.data();
+            const std::byte* end = in + payload.size();
+            auto Read = [&]<typename T>(T& value) {
+                if (usz(end - in) < sizeof(T)) {
+                    throw std::runtime_error("Truncated log record");
+                }
+                std::memcpy(&value, in, sizeof(T));
+                in += sizeof(T);
+            };
+
+            for (u32 i = 0; i < site.arg_count; ++i) {
+                if (site.arg_types[i] == LogArgType::String) {
+                    u32 size;
+                    Read(size);
+                    if (usz(end - in) < size) {
+                        throw std::runtime_error("Truncated log record");
+                    }
+                    store.push_back(std::string_view(reinterpret_cast<const char*>(in), size));
+                    in += size;
+                    continue;
+                }
+
+                if (site.arg_types[i] == LogArgType::F32) {
+                    f32 value;
+                    Read(value);
+                    store.push_back(value);
+                    continue;
+                }
+
+                u64 bits;
+                Read(bits);
+                switch (site.arg_types[i]) {
+                    break;case LogArgType::Bool:    store.push_back(bits != 0);
+                    break;case LogArgType::Char:    store.push_back(char(bits));
+                    break;case LogArgType::I64:     store.push_back(i64(bits));
+                    break;case LogArgType::U64:     store.push_back(bits);
+                    break;case LogArgType::F64:     store.push_back(std::bit_cast<f64>(bits));
+                    break;case LogArgType::Pointer: store.push_back(reinterpret_cast<const void*>(uintptr_t(bits)));
+                    break;default: throw std::runtime_error("Invalid log argument type");
+                }
+            }
+
+            fmt::vformat_to(std::back_inserter(out), site.format, store);
+        }
+
+        // Single producer byte ring for deferred messages, written only by its owning thread and read by the
+        // logging thread. Records are 8 byte aligned and never wrap, a record with a null site pads to the end.
+
+        struct ThreadLogBuffer
+        {
+            static constexpr u64 Capacity  = 64 * 1024;
+            static constexpr u64 MaxRecord = Capacity / 4;
+
+            struct Record
+            {
+                u32            size; // Including this header, rounded up to 8 bytes
+                u32    payload_size;
+                const LogSite* site;
+                i64            time;
+            };
+
+            std::unique_ptr<std::byte[]> data{ new std::byte[Capacity] };
+
+            alignas(64) std::atomic<u64> head = 0;
+            alignas(64) std::atomic<u64> tail = 0;
+            std::atomic<bool>         retired = false;
+        };
+
+        // Buffer of the calling thread. Trivially destructible, so they stay usable from thread_local destructors
+        // that run after the owner below has retired the buffer
+        inline thread_local ThreadLogBuffer* ThreadLogBufferLocal = nullptr;
+        inline thread_local bool           ThreadLogBufferRetired = false;
+
+        // Marks the calling thread's buffer as retired on thread exit, it is freed once drained. Messages deferred
+        // after that are formatted on the calling thread instead
+        struct ThreadLogBufferOwner
+        {
+            ThreadLogBuffer* buffer = nullptr;
+
+            ~ThreadLogBufferOwner()
+            {
+                ThreadLogBufferLocal = nullptr;
+                ThreadLogBufferRetired = true;
+                if (buffer) {
+                    buffer->retired.store(true, std::memory_order_release);
+                }
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        // Asynchronous log backend.
+        //
+        // Formatted messages go into a bounded MPSC ring: producers claim a sequence numbered slot with a single CAS
+        // and format directly into it. Deferred messages are copied as raw argument bytes into a per-thread byte ring
+        // and are only formatted on the logging thread, if any sink needs text at all. The logging thread takes
+        // everything ready from both, orders the batch by time and hands it to the sinks in one call.
+        // Slot buffers keep their capacity between uses so steady state logging does not allocate.
+        //
+        // When a buffer is full producers yield until the logging thread catches up rather than dropping messages.
+        // Error messages wait until written, so that they are not lost if the process then crashes, as do untagged
+        // messages from plain Log() so that they keep their order against direct writes to stdout. After exit
+        // handlers run, messages are written synchronously on the calling thread.
+
+        class Logger
+        {
+            static constexpr u64 Capacity = 1024;
+            static constexpr u64 Mask     = Capacity - 1;
+
+            struct Slot
+            {
+                std::atomic<u64>            sequence;
+                LogLevel                       level;
+                bool                          tagged;
+                chr::system_clock::time_point   time;
+                fmt::basic_memory_buffer<char, 240> text;
+            };
+
+            struct PendingBuffer
+            {
+                ThreadLogBuffer* buffer;
+                u64                head;
+            };
+
+            std::unique_ptr<Slot[]> slots{ new Slot[Capacity] };
+
+            alignas(64) std::atomic<u64>            head = 0;
+            alignas(64) std::atomic<u64> flush_requested = 0;
+            alignas(64) std::atomic<u64> flush_completed = 0;
+            alignas(64) std::atomic<u32>          signal = 0;
+            std::atomic<bool>                   sleeping = false;
+            std::atomic<bool>                synchronous = false;
+
+            std::mutex                                     buffers_mutex;
+            std::vector<std::unique_ptr<ThreadLogBuffer>>        buffers;
+
+            std::mutex                            sink_mutex;
+            std::vector<std::shared_ptr<LogSink>>      sinks;
+
+            std::vector<LogMessage>       batch;
+            std::vector<PendingBuffer>  pending;
+            fmt::memory_buffer           text_storage;
+            std::vector<std::pair<usz, usz>> text_ranges;
+
+            std::thread thread;
+
+            static inline thread_local bool                  on_log_thread = false;
+            static inline thread_local ThreadLogBufferOwner thread_buffer;
+
+        public:
+            std::atomic<LogLevel> level = LogLevel::Trace;
+
+        public:
+            Logger()
+            {
+                for (u64 i = 0; i < Capacity; ++i) {
+                    slots[i].sequence.store(i, std::memory_order_relaxed);
+                }
+                sinks.emplace_back(std::make_shared<ConsoleLogSink>());
+                thread = std::thread([this] { Run(); });
+                thread.detach();
+                std::atexit([] { Get().Shutdown(); });
+            }
+
+            static Logger& Get()
+            {
+                return LeakedInstance<Logger>();
+            }
+
+            void Write(LogLevel message_level, bool tagged, fmt::string_view format, fmt::format_args args)
+            {
+                if (synchronous.load(std::memory_order_acquire)) {
+                    WriteSynchronous(message_level, tagged, format, args);
+                    return;
+                }
+
+                u64 pos = head.load(std::memory_order_relaxed);
+                Slot* slot;
+                for (;;) {
+                    slot = &slots[pos & Mask];
+                    i64 diff = i64(slot->sequence.load(std::memory_order_acquire)) - i64(pos);
+                    if (diff == 0) {
+                        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else {
+                        if (diff < 0) {
+                            // Full, the slot is still waiting to be written out
+                            Wake();
+                            std::this_thread::yield();
+                        }
+                        pos = head.load(std::memory_order_relaxed);
+                    }
+                }
+
+                slot->level = message_level;
+                slot->tagged = tagged;
+                slot->time = chr::system_clock::now();
+                slot->text.clear();
+                try {
+                    fmt::vformat_to(std::back_inserter(slot->text), format, args);
+                } catch (...) {
+                    // The slot has been claimed and must be published regardless
+                    slot->text.clear();
+                    constexpr std::string_view Failed = "<log formatting failed>";
+                    slot->text.append(Failed.data(), Failed.data() + Failed.size());
+                }
+                slot->sequence.store(pos + 1, std::memory_order_release);
+
+                Published();
+
+                // Plain Log() output stays synchronous with respect to direct stdout writes, e.g. prompts
+                if (message_level >= LogLevel::Error || !tagged) {
+                    Flush();
+                }
+            }
+
+            // Returns false if the arguments are too large to defer or the thread is exiting and its buffer has been
+            // retired, in which case the caller formats them instead
+            template<typename... Args>
+            bool WriteDeferred(const LogSite& site, const Args&... args)
+            {
+                if (synchronous.load(std::memory_order_acquire)) {
+                    return false;
+                }
+
+                using Record = ThreadLogBuffer::Record;
+
+                usz payload_size = (usz(0) + ... + LogArgSize(args));
+                usz size = AlignUpPower2(sizeof(Record) + payload_size, 8);
+                if (size > ThreadLogBuffer::MaxRecord) {
+                    return false;
+                }
+
+                if (!ThreadLogBufferLocal && ThreadLogBufferRetired) {
+                    return false;
+                }
+                auto& buffer = ThreadLogBufferLocal ? *ThreadLogBufferLocal : RegisterThreadBuffer();
+
+                u64 pos = buffer.head.load(std::memory_order_relaxed);
+                u64 offset = pos % ThreadLogBuffer::Capacity;
+                u64 padding = (offset + size > ThreadLogBuffer::Capacity) ? ThreadLogBuffer::Capacity - offset : 0;
+
+                while (pos + padding + size - buffer.tail.load(std::memory_order_acquire) > ThreadLogBuffer::Capacity) {
+                    Wake();
+                    std::this_thread::yield();
+                }
+
+                if (padding) {
+                    // Ends too small for a header are skipped implicitly by the reader
+                    if (padding >= sizeof(Record)) {
+                        Record pad{ .size = u32(padding), .payload_size = 0, .site = nullptr, .time = 0 };
+                        std::memcpy(buffer.data.get() + offset, &pad, sizeof(pad));
+                    }
+                    offset = 0;
+                }
+
+                std::byte* out = buffer.data.get() + offset;
+                Record record{
+                    .size = u32(size),
+                    .payload_size = u32(payload_size),
+                    .site = &site,
+                    .time = chr::system_clock::now().time_since_epoch().count(),
+                };
+                std::memcpy(out, &record, sizeof(record));
+                out += sizeof(record);
+                ((out = EncodeLogArg(out, args)), ...);
+
+                buffer.head.store(pos + padding + size, std::memory_order_release);
+
+                Published();
+
+                if (site.level >= LogLevel::Error) {
+                    Flush();
+                }
+
+                return true;
+            }
+
+            // Blocks until every message submitted before the call has been written to the sinks
+            void Flush()
+            {
+                if (on_log_thread) {
+                    // Sinks that log would otherwise wait on themselves
+                    return;
+                }
+
+                u64 ticket = flush_requested.fetch_add(1, std::memory_order_seq_cst) + 1;
+                u64 completed = flush_completed.load(std::memory_order_acquire);
+                while (completed < ticket) {
+                    Wake();
+                    flush_completed.wait(completed, std::memory_order_acquire);
+                    completed = flush_completed.load(std::memory_order_acquire);
+                }
+            }
+
+            void AddSink(std::shared_ptr<LogSink> sink)
+            {
+                std::scoped_lock lock{sink_mutex};
+                sinks.emplace_back(std::move(sink));
+            }
+
+            void RemoveSink(const std::shared_ptr<LogSink>& sink)
+            {
+                std::scoped_lock lock{sink_mutex};
+                std::erase(sinks, sink);
+            }
+
+            void ClearSinks()
+            {
+                std::scoped_lock lock{sink_mutex};
+                sinks.clear();
+            }
+
+        private:
+            void Wake()
+            {
+                signal.fetch_add(1, std::memory_order_seq_cst);
+                signal.notify_one();
+            }
+
+            void Published()
+            {
+                // Only the first producer to see the logging thread asleep pays for the wake
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false, std::memory_order_relaxed)) {
+                    Wake();
+                }
+            }
+
+            NOVA_NO_INLINE
+            ThreadLogBuffer& RegisterThreadBuffer()
+            {
+                std::scoped_lock lock{buffers_mutex};
+                return *(ThreadLogBufferLocal = thread_buffer.buffer = buffers.emplace_back(new ThreadLogBuffer).get());
+            }
+
+            void Shutdown()
+            {
+                Flush();
+                synchronous.store(true, std::memory_order_release);
+            }
+
+            void WriteSynchronous(LogLevel message_level, bool tagged, fmt::string_view format, fmt::format_args args)
+            {
+                fmt::memory_buffer text;
+                fmt::vformat_to(std::back_inserter(text), format, args);
+
+                LogMessage message{ message_level, tagged, chr::system_clock::now(), StringView(text.data(), text.size()) };
+
+                // Sinks are called outside the lock, so a sink that logs or adds/removes sinks cannot deadlock
+                std::vector<std::shared_ptr<LogSink>> targets;
+                {
+                    std::scoped_lock lock{sink_mutex};
+                    targets = sinks;
+                }
+
+                for (auto& sink : targets) {
+                    sink->Write({ &message, 1 });
+                }
+            }
+
+            bool IsReady(u64 pos)
+            {
+                return slots[pos & Mask].sequence.load(std::memory_order_acquire) == pos + 1;
+            }
+
+            bool HasDeferred()
+            {
+                std::scoped_lock lock{buffers_mutex};
+                for (auto& buffer : buffers) {
+                    if (buffer->head.load(std::memory_order_acquire) != buffer->tail.load(std::memory_order_relaxed)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void Run()
+            {
+                on_log_thread = true;
+
+                u64 tail = 0;
+                for (;;) {
+                    u64 flush_target = flush_requested.load(std::memory_order_acquire);
+
+                    // Snapshot the thread buffers before the ring. A deferred message is published after any formatted
+                    // message that its thread logged before it, so that message is then guaranteed to be visible too.
+                    pending.clear();
+                    {
+                        std::scoped_lock lock{buffers_mutex};
+                        std::erase_if(buffers, [](auto& buffer) {
+                            return buffer->retired.load(std::memory_order_acquire)
+                                && buffer->head.load(std::memory_order_acquire) == buffer->tail.load(std::memory_order_relaxed);
+                        });
+                        for (auto& buffer : buffers) {
+                            u64 buffer_head = buffer->head.load(std::memory_order_acquire);
+                            if (buffer_head != buffer->tail.load(std::memory_order_relaxed)) {
+                                pending.push_back({ buffer.get(), buffer_head });
+                            }
+                        }
+                    }
+
+                    u64 end = tail;
+                    while (end - tail < Capacity && IsReady(end)) {
+                        auto& slot = slots[end & Mask];
+                        batch.push_back({ slot.level, slot.tagged, slot.time, StringView(slot.text.data(), slot.text.size()) });
+                        ++end;
+                    }
+                    bool drained = !IsReady(end);
+
+                    for (auto[buffer, buffer_head] : pending) {
+                        for (u64 pos = buffer->tail.load(std::memory_order_relaxed); pos != buffer_head;) {
+                            u64 offset = pos % ThreadLogBuffer::Capacity;
+                            if (ThreadLogBuffer::Capacity - offset < sizeof(ThreadLogBuffer::Record)) {
+                                pos += ThreadLogBuffer::Capacity - offset;
+                                continue;
+                            }
+
+                            ThreadLogBuffer::Record record;
+                            std::byte* in = buffer->data.get() + offset;
+                            std::memcpy(&record, in, sizeof(record));
+                            pos += record.size;
+                            if (!record.site) {
+                                continue;
+                            }
+
+                            batch.push_back({
+                                .level = record.site->level,
+                                .tagged = true,
+                                .time = chr::system_clock::time_point(chr::system_clock::duration(record.time)),
+                                .text = {},
+                                .site = record.site,
+                                .payload = { in + sizeof(record), record.payload_size },
+                            });
+                        }
+                    }
+
+                    if (batch.empty()) {
+                        if (flush_completed.load(std::memory_order_relaxed) < flush_target) {
+                            flush_completed.store(flush_target, std::memory_order_release);
+                            flush_completed.notify_all();
+                            continue;
+                        }
+
+                        sleeping.store(true, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        u32 s = signal.load(std::memory_order_relaxed);
+                        if (!IsReady(tail) && !HasDeferred() && flush_requested.load(std::memory_order_relaxed) == flush_target) {
+                            signal.wait(s, std::memory_order_relaxed);
+                        }
+                        sleeping.store(false, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    if (!pending.empty()) {
+                        std::ranges::stable_sort(batch, {}, &LogMessage::time);
+                    }
+
+                    {
+                        std::scoped_lock lock{sink_mutex};
+
+                        if (!pending.empty() && std::ranges::any_of(sinks, [](auto& sink) { return sink->NeedsText(); })) {
+                            FormatDeferred();
+                        }
+
+                        for (auto& sink : sinks) {
+                            try {
+                                sink->Write(batch);
+                            } catch (...) {}
+                        }
+                    }
+                    batch.clear();
+
+                    for (u64 i = tail; i < end; ++i) {
+                        slots[i & Mask].sequence.store(i + Capacity, std::memory_order_release);
+                    }
+                    tail = end;
+
+                    for (auto[buffer, buffer_head] : pending) {
+                        buffer->tail.store(buffer_head, std::memory_order_release);
+                    }
+
+                    if (drained && flush_completed.load(std::memory_order_relaxed) < flush_target) {
+                        flush_completed.store(flush_target, std::memory_order_release);
+                        flush_completed.notify_all();
+                    }
+                }
+            }
+
+            void FormatDeferred()
+            {
+                // Format into one shared buffer first, as views can only be taken once it stops growing
+                text_storage.clear();
+                text_ranges.clear();
+                for (auto& message : batch) {
+                    if (!message.site) {
+                        continue;
+                    }
+                    usz offset = text_storage.size();
+                    try {
+                        FormatLogRecord(text_storage, *message.site, message.payload);
+                    } catch (...) {
+                        constexpr std::string_view Failed = "<log formatting failed>";
+                        text_storage.append(Failed.data(), Failed.data() + Failed.size());
+                    }
+                    text_ranges.emplace_back(offset, text_storage.size() - offset);
+                }
+
+                usz next = 0;
+                for (auto& message : batch) {
+                    if (message.site) {
+                        auto[offset, size] = text_ranges[next++];
+                        message.text = StringView(text_storage.data() + offset, size);
+                    }
+                }
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+
+    inline
+    void SetLogLevel(LogLevel level) noexcept
+    {
+        detail::Logger::Get().level.store(level, std::memory_order_relaxed);
+    }
+
+    inline
+    LogLevel GetLogLevel() noexcept
+    {
+        return detail::Logger::Get().level.load(std::memory_order_relaxed);
+    }
+
+    inline
+    bool IsLogEnabled(LogLevel level) noexcept
+    {
+        return level >= GetLogLevel();
+    }
+
+    inline
+    void AddLogSink(std::shared_ptr<LogSink> sink)
+    {
+        detail::Logger::Get().AddSink(std::move(sink));
+    }
+
+    inline
+    void RemoveLogSink(const std::shared_ptr<LogSink>& sink)
+    {
+        detail::Logger::Get().RemoveSink(sink);
+    }
+
+    inline
+    void ClearLogSinks()
+    {
+        detail::Logger::Get().ClearSinks();
+    }
+
+    inline
+    void FlushLog()
+    {
+        detail::Logger::Get().Flush();
+    }
+
+    template<typename ...Args>
+    void Log(LogLevel level, const fmt::format_string<Args...> fmt, Args&&... args)
+    {
+        detail::Logger::Get().Write(level, true, fmt.get(), fmt::make_format_args(args...));
+    }
+
+    inline
+    void Log(StringView str)
+    {
+        detail::Logger::Get().Write(LogLevel::Info, false, "{}", fmt::make_format_args(str));
+    }
+
+    template<typename ...Args>
+    void Log(const fmt::format_string<Args...> fmt, Args&&... args)
+    {
+        detail::Logger::Get().Write(LogLevel::Info, false, fmt.get(), fmt::make_format_args(args...));
+    }
+
+    namespace detail
+    {
+        struct LogSiteInfo
+        {
+            LogLevel     level;
+            const char* format;
+            const char*   file;
+            u32           line;
+        };
+
+        // Captures the arguments as raw bytes when every argument has a deferrable type, and formats immediately
+        // otherwise. SiteFn is a unique constexpr callable per call site that describes it.
+        template<typename SiteFn, typename... Args>
+        void LogAt(SiteFn, const fmt::format_string<Args...> fmt, Args&&... args)
+        {
+            static constexpr LogSiteInfo Info = SiteFn{}();
+
+            if constexpr (NOVA_LOG_DEFERRED && LogDeferrable<Args...>) {
+                static constexpr LogSite Site {
+                    .level = Info.level,
+                    .format = Info.format,
+                    .file = Info.file,
+                    .line = Info.line,
+                    .arg_count = u32(sizeof...(Args)),
+                    .arg_types = LogArgTypes<Args...>.data(),
+                };
+                if (Logger::Get().WriteDeferred(Site, args...)) {
+                    return;
+                }
+            }
+
+            Log(Info.level, fmt, std::forward<Args>(args)...);
         }
+    }
 
+// -----------------------------------------------------------------------------
+//                               Binary Logs
 // -----------------------------------------------------------------------------
 
-        constexpr bool IsNullTerminated() const noexcept
-        {
-            return null_terminated;
-        }
+    // Writes messages without formatting them. Deferred messages are stored as their raw argument bytes, with each
+    // call site written once on first use, so the log can be formatted later with ReadBinaryLog.
+    //
+    // Layout: "NOVALOG1" followed by entries, each a u8 kind and its fields in native byte order.
+    //   Site:     u32 id, u8 level, u32 line, u32 arg_count, u8 arg_types[arg_count], string format, string file
+    //   Deferred: u32 site id, i64 time (ns since epoch), u32 payload size, payload
+    //   Text:     u8 level, u8 tagged, i64 time (ns since epoch), string text
+    // Strings are a u32 length followed by the bytes.
 
-        constexpr usz Size() const noexcept
-        {
-            return length;
-        }
+    class BinaryLogSink : public LogSink
+    {
+    public:
+        static constexpr std::string_view Magic = "NOVALOG1";
 
-        constexpr const CharT* begin() const noexcept
+        enum class Entry : u8
         {
-            return data;
-        }
+            Site = 1,
+            Deferred,
+            Text,
+        };
 
-        constexpr const CharT* end() const noexcept
+    private:
+        std::ofstream                 file;
+        std::vector<char>           buffer;
+        HashMap<const LogSite*, u32> sites;
+
+        template<typename T>
+        void Put(const T& value)
         {
-            return data + length;
+            auto bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
         }
 
-        constexpr const CharT* Data() const noexcept
+        void PutString(std::string_view str)
         {
-            return data;
+            Put(u32(str.size()));
+            buffer.insert(buffer.end(), str.begin(), str.end());
         }
 
-        constexpr CString<CharT> CStr() const
+        static i64 ToNanos(chr::system_clock::time_point time)
         {
-            return CString<CharT>(data, length, null_terminated);
+            return chr::duration_cast<chr::nanoseconds>(time.time_since_epoch()).count();
         }
 
-// -----------------------------------------------------------------------------
-
-        constexpr explicit operator std::basic_string<CharT>() const
+    public:
+        BinaryLogSink(const std::filesystem::path& path)
+            : file(path, std::ios::binary | std::ios::trunc)
         {
-            return std::basic_string<CharT>(data, length);
+            if (!file) {
+                throw std::runtime_error(fmt::format("Failed to open log file: {}", path.string()));
+            }
+            file.write(Magic.data(), std::streamsize(Magic.size()));
         }
 
-        constexpr operator std::basic_string_view<CharT>() const noexcept
+        bool NeedsText() const override
         {
-            return std::basic_string_view<CharT>(data, length);
+            return false;
         }
 
-        constexpr operator fs::path() const noexcept
+        void Write(Span<LogMessage> messages) override
         {
-            return fs::path(std::basic_string_view<CharT>(*this));
-        }
+            for (auto& message : messages) {
+                if (!message.site) {
+                    Put(Entry::Text);
+                    Put(message.level);
+                    Put(u8(message.tagged));
+                    Put(ToNanos(message.time));
+                    PutString(message.text);
+                    continue;
+                }
 
-// -----------------------------------------------------------------------------
+                auto[iter, inserted] = sites.try_emplace(message.site, u32(sites.size()));
+                if (inserted) {
+                    auto& site = *message.site;
+                    Put(Entry::Site);
+                    Put(iter->second);
+                    Put(site.level);
+                    Put(site.line);
+                    Put(site.arg_count);
+                    for (u32 i = 0; i < site.arg_count; ++i) {
+                        Put(site.arg_types[i]);
+                    }
+                    PutString(site.format);
+                    PutString(site.file);
+                }
 
-        constexpr bool operator==(const BasicStringView& other) const noexcept
-        {
-            if (length != other.length) return false;
-            return std::memcmp(data, other.data, length) == 0;
+                Put(Entry::Deferred);
+                Put(iter->second);
+                Put(ToNanos(message.time));
+                Put(u32(message.payload.size()));
+                buffer.insert(buffer.end(), reinterpret_cast<const char*>(message.payload.data()),
+                    reinterpret_cast<const char*>(message.payload.data()) + message.payload.size());
+            }
+
+            file.write(buffer.data(), std::streamsize(buffer.size()));
+            file.flush();
+            buffer.clear();
         }
     };
 
-    template<typename CharT>
-    std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicStringView<CharT>& str)
+    // Formats every message in a log written by BinaryLogSink, invoking fn(const LogMessage&) in order
+    template<typename Fn>
+    void ReadBinaryLog(std::istream& in, Fn&& fn)
     {
-        return os << std::basic_string_view<CharT>(str);
-    }
-
-    using StringView = BasicStringView<char>;
-}
-
-namespace fmt
-{
-    template<typename CharT>
-    struct formatter<::nova::BasicStringView<CharT>> : ostream_formatter {};
-}
+        struct OwnedSite
+        {
+            std::string               format;
+            std::string                 file;
+            std::vector<LogArgType> arg_types;
+            LogSite                      site;
+        };
 
-// -----------------------------------------------------------------------------
-//                               Formatting
-// -----------------------------------------------------------------------------
+        auto Get = [&]<typename T>(T& value) {
+            if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+                throw std::runtime_error("Truncated binary log");
+            }
+        };
 
-namespace nova
-{
-    inline
-    std::string Fmt(StringView str)
-    {
-        return std::string(str);
-    }
+        auto GetString = [&](auto& str) {
+            u32 size;
+            Get(size);
+            str.resize(size);
+            if (size && !in.read(reinterpret_cast<char*>(str.data()), size)) {
+                throw std::runtime_error("Truncated binary log");
+            }
+        };
 
-    template<typename ...Args>
-    std::string Fmt(const fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        return fmt::vformat(fmt.get(), fmt::make_format_args(args...));
-    }
-}
+        std::array<char, BinaryLogSink::Magic.size()> magic;
+        if (!in.read(magic.data(), magic.size()) || std::string_view(magic.data(), magic.size()) != BinaryLogSink::Magic) {
+            throw std::runtime_error("Not a nova binary log");
+        }
 
-// -----------------------------------------------------------------------------
-//                                 Logging
-// -----------------------------------------------------------------------------
+        std::vector<std::unique_ptr<OwnedSite>> sites;
+        std::vector<std::byte> payload;
+        std::string text;
+        fmt::memory_buffer formatted;
 
-namespace nova
-{
-    inline
-    void Log(StringView str)
-    {
-        std::cout << str << '\n';
-    }
+        auto ToTime = [](i64 nanos) {
+            return chr::system_clock::time_point(chr::duration_cast<chr::system_clock::duration>(chr::nanoseconds(nanos)));
+        };
 
-    template<typename ...Args>
-    void Log(const fmt::format_string<Args...> fmt, Args&&... args)
-    {
-        std::cout << Fmt(fmt, std::forward<Args>(args)...) << '\n';
+        BinaryLogSink::Entry entry;
+        while (in.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+            switch (entry) {
+                break;case BinaryLogSink::Entry::Site: {
+                    u32 id;
+                    Get(id);
+                    if (id != sites.size()) {
+                        throw std::runtime_error("Invalid binary log site id");
+                    }
+                    auto& owned = *sites.emplace_back(new OwnedSite);
+                    Get(owned.site.level);
+                    Get(owned.site.line);
+                    Get(owned.site.arg_count);
+                    owned.arg_types.resize(owned.site.arg_count);
+                    for (auto& type : owned.arg_types) {
+                        Get(type);
+                    }
+                    GetString(owned.format);
+                    GetString(owned.file);
+                    owned.site.format = owned.format.c_str();
+                    owned.site.file = owned.file.c_str();
+                    owned.site.arg_types = owned.arg_types.data();
+                }
+                break;case BinaryLogSink::Entry::Deferred: {
+                    u32 id;
+                    i64 time;
+                    Get(id);
+                    Get(time);
+                    GetString(payload);
+                    if (id >= sites.size()) {
+                        throw std::runtime_error("Invalid binary log site id");
+                    }
+                    auto& site = sites[id]->site;
+                    formatted.clear();
+                    detail::FormatLogRecord(formatted, site, payload);
+                    fn(LogMessage {
+                        .level = site.level,
+                        .tagged = true,
+                        .time = ToTime(time),
+                        .text = StringView(formatted.data(), formatted.size()),
+                        .site = &site,
+                        .payload = payload,
+                    });
+                }
+                break;case BinaryLogSink::Entry::Text: {
+                    LogLevel level;
+                    u8 tagged;
+                    i64 time;
+                    Get(level);
+                    Get(tagged);
+                    Get(time);
+                    GetString(text);
+                    fn(LogMessage {
+                        .level = level,
+                        .tagged = bool(tagged),
+                        .time = ToTime(time),
+                        .text = text,
+                    });
+                }
+                break;default:
+                    throw std::runtime_error("Invalid binary log entry");
+            }
+        }
     }
 }
 
-#define LogTrace(fmt, ...) Log("[\u001B[90mTRACE\u001B[0m] \u001B[90m" fmt "\u001B[0m" __VA_OPT__(,) __VA_ARGS__)
-// #define LogTrace(fmt, ...)
-#define LogDebug(fmt, ...) Log("[\u001B[96mDEBUG\u001B[0m] " fmt "\u001B[0m" __VA_OPT__(,) __VA_ARGS__)
-#define LogInfo(fmt, ...) Log("[\u001B[94mINFO\u001B[0m] " fmt "\u001B[0m" __VA_OPT__(,) __VA_ARGS__)
-#define LogWarn(fmt, ...) Log("[\u001B[93mWARN\u001B[0m] " fmt "\u001B[0m" __VA_OPT__(,) __VA_ARGS__)
-#define LogError(fmt, ...) Log("[\u001B[91mERROR\u001B[0m] " fmt "\u001B[0m" __VA_OPT__(,) __VA_ARGS__)
+#define NOVA_LOG_AT(level, fmt, ...) do {                                      \
+    if constexpr (std::to_underlying(level) >= NOVA_LOG_LEVEL) {               \
+        if (::nova::IsLogEnabled(level))                                       \
+            ::nova::detail::LogAt([]() consteval {                             \
+                return ::nova::detail::LogSiteInfo{ level, fmt, __FILE__, __LINE__ }; \
+            }, fmt __VA_OPT__(,) __VA_ARGS__);                                 \
+    }                                                                          \
+} while (0)
+
+#define LogTrace(fmt, ...) NOVA_LOG_AT(::nova::LogLevel::Trace, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LogDebug(fmt, ...) NOVA_LOG_AT(::nova::LogLevel::Debug, fmt __VA_OPT__(,) __VA_ARGS__)
+#define LogInfo(fmt, ...)  NOVA_LOG_AT(::nova::LogLevel::Info,  fmt __VA_OPT__(,) __VA_ARGS__)
+#define LogWarn(fmt, ...)  NOVA_LOG_AT(::nova::LogLevel::Warn,  fmt __VA_OPT__(,) __VA_ARGS__)
+#define LogError(fmt, ...) NOVA_LOG_AT(::nova::LogLevel::Error, fmt __VA_OPT__(,) __VA_ARGS__)
 
 // -----------------------------------------------------------------------------
 //                                Exceptions
@@ -1315,6 +2922,7 @@ namespace nova
                 "Error: {}\n"
                 "────────────────────────────────────────────────────────────────────────────────",
                 What());
+            FlushLog();
         }
     public:
 
@@ -1419,12 +3027,56 @@ namespace nova::detail
 
 namespace nova
 {
+    // Buffer conversions write into caller-provided storage and return the number of code units written. Output
+    // must have room for the worst case: source.Size() units for ToUtf16/ToUtf32, 3 * source.Size() bytes for
+    // FromUtf16 and 4 * source.Size() bytes for FromUtf32. Invalid input produces an empty result.
+    //
+    // Pure ASCII input, by far the common case for UI and paths, skips transcoding and is widened directly.
+
+    inline
+    bool IsAscii(StringView source) noexcept
+    {
+        return simdutf::validate_ascii(source.Data(), source.Size());
+    }
+
+    inline
+    usz ToUtf16(StringView source, wchar_t* output) noexcept
+    {
+        static_assert(sizeof(wchar_t) == sizeof(char16_t));
+        if (IsAscii(source)) {
+            return simdutf::convert_latin1_to_utf16le(source.Data(), source.Size(), reinterpret_cast<char16_t*>(output));
+        }
+        return simdutf::convert_utf8_to_utf16(source.Data(), source.Size(), reinterpret_cast<char16_t*>(output));
+    }
+
+    inline
+    usz FromUtf16(BasicStringView<wchar_t> source, char* output) noexcept
+    {
+        return simdutf::convert_utf16_to_utf8(reinterpret_cast<const char16_t*>(source.Data()), source.Size(), output);
+    }
+
+    inline
+    usz ToUtf32(StringView source, c32* output) noexcept
+    {
+        if (IsAscii(source)) {
+            return simdutf::convert_latin1_to_utf32(source.Data(), source.Size(), output);
+        }
+        return simdutf::convert_utf8_to_utf32(source.Data(), source.Size(), output);
+    }
+
+    inline
+    usz FromUtf32(BasicStringView<char32_t> source, char* output) noexcept
+    {
+        return simdutf::convert_utf32_to_utf8(source.Data(), source.Size(), output);
+    }
+
+// -----------------------------------------------------------------------------
+
     inline
     std::wstring ToUtf16(StringView source)
     {
         std::wstring out(source.Size(), '\0');
-        auto len = simdutf::convert_utf8_to_utf16(source.Data(), source.Size(), (char16_t*)out.data());
-        out.resize(len);
+        out.resize(ToUtf16(source, out.data()));
         return out;
     }
 
@@ -1432,8 +3084,7 @@ namespace nova
     std::string FromUtf16(BasicStringView<wchar_t> source)
     {
         std::string out(source.Size() * 3, '\0');
-        auto len = simdutf::convert_utf16_to_utf8((const char16_t*)source.Data(), source.Size(), out.data());
-        out.resize(len);
+        out.resize(FromUtf16(source, out.data()));
         return out;
     }
 
@@ -1441,8 +3092,7 @@ namespace nova
     std::basic_string<char32_t> ToUtf32(StringView source)
     {
         std::basic_string<char32_t> out(source.Size(), '\0');
-        auto len = simdutf::convert_utf8_to_utf32(source.Data(), source.Size(), out.data());
-        out.resize(len);
+        out.resize(ToUtf32(source, out.data()));
         return out;
     }
 
@@ -1450,12 +3100,152 @@ namespace nova
     std::string FromUtf32(BasicStringView<char32_t> source)
     {
         std::string out(source.Size() * 4, '\0');
-        auto len = simdutf::convert_utf32_to_utf8(source.Data(), source.Size(), out.data());
-        out.resize(len);
+        out.resize(FromUtf32(source, out.data()));
         return out;
     }
 }
 
+// -----------------------------------------------------------------------------
+//                          UTF-8 Codepoint Iteration
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Decodes UTF-8 one codepoint at a time without an intermediate buffer, for use in range-for loops:
+    //
+    //   for (c32 c : Utf8Codepoints(str)) { ... }
+    //
+    // Malformed sequences (truncated, overlong, surrogates or out of range) decode as U+FFFD and consume a single
+    // byte, so iteration always makes progress and never reads past the end of the view.
+
+    class Utf8Codepoints
+    {
+        const u8* first;
+        const u8*  last;
+
+    public:
+        static constexpr c32 Replacement = 0xFFFD;
+
+        struct Sentinel {};
+
+        class Iterator
+        {
+            const u8* ptr = nullptr;
+            const u8* end = nullptr;
+            c32 codepoint = 0;
+            u32      size = 0;
+
+        public:
+            using value_type      = c32;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            Iterator(const u8* _ptr, const u8* _end) noexcept
+                : ptr(_ptr)
+                , end(_end)
+            {
+                Decode();
+            }
+
+            c32 operator*() const noexcept
+            {
+                return codepoint;
+            }
+
+            // Byte offset of the next codepoint relative to the current one
+            u32 GetSize() const noexcept
+            {
+                return size;
+            }
+
+            Iterator& operator++() noexcept
+            {
+                ptr += size;
+                Decode();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator prev = *this;
+                ++*this;
+                return prev;
+            }
+
+            bool operator==(Sentinel) const noexcept
+            {
+                return ptr == end;
+            }
+
+        private:
+            void Decode() noexcept
+            {
+                if (ptr == end) {
+                    return;
+                }
+
+                u8 lead = ptr[0];
+                if (lead < 0x80) [[likely]] {
+                    codepoint = lead;
+                    size = 1;
+                    return;
+                }
+
+                u32 length;
+                c32 min;
+                if      ((lead & 0xE0) == 0xC0) { length = 2; min = 0x80;    codepoint = lead & 0x1F; }
+                else if ((lead & 0xF0) == 0xE0) { length = 3; min = 0x800;   codepoint = lead & 0x0F; }
+                else if ((lead & 0xF8) == 0xF0) { length = 4; min = 0x10000; codepoint = lead & 0x07; }
+                else {
+                    codepoint = Replacement;
+                    size = 1;
+                    return;
+                }
+
+                if (usz(end - ptr) < length) {
+                    codepoint = Replacement;
+                    size = 1;
+                    return;
+                }
+
+                for (u32 i = 1; i < length; ++i) {
+                    if ((ptr[i] & 0xC0) != 0x80) {
+                        codepoint = Replacement;
+                        size = 1;
+                        return;
+                    }
+                    codepoint = (codepoint << 6) | (ptr[i] & 0x3F);
+                }
+
+                if (codepoint < min || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+                    codepoint = Replacement;
+                    size = 1;
+                    return;
+                }
+
+                size = length;
+            }
+        };
+
+    public:
+        Utf8Codepoints(StringView str) noexcept
+            : first(reinterpret_cast<const u8*>(str.Data()))
+            , last(first + str.Size())
+        {}
+
+        Iterator begin() const noexcept
+        {
+            return { first, last };
+        }
+
+        Sentinel end() const noexcept
+        {
+            return {};
+        }
+    };
+}
+
 // -----------------------------------------------------------------------------
 //                    Duration / Size String Conversions
 // -----------------------------------------------------------------------------
@@ -1720,33 +3510,118 @@ namespace nova::env
 //                          Nova Supplementary Stack
 // -----------------------------------------------------------------------------
 
+namespace nova
+{
+    struct ThreadStackUsage
+    {
+        std::thread::id thread;
+        usz         high_water;
+        usz          committed;
+    };
+}
+
 namespace nova::detail
 {
+    // Per-thread bump stack for temporary arrays.
+    //
+    // The full range is reserved on first use, and pages are committed in chunks as the stack grows. A guard region
+    // past the end is never committed, so writes that overrun the final allocation fault instead of corrupting
+    // neighbouring memory, and allocations that would not fit throw.
+    //
+    // The high-water mark is only updated when the stack is rewound, which keeps allocation to a single compare.
+
     struct ThreadStack
     {
-        std::byte* ptr;
+        std::byte*       ptr;
+        std::byte* committed;
 
         std::byte* beg;
         std::byte* end;
 
-        static constexpr usz StackSize = 128ull * 1024 * 1024;
+        std::thread::id                  thread;
+        std::atomic<std::byte*>      high_water;
+        std::atomic<usz>        committed_bytes = 0;
+
+        static constexpr usz StackSize  = 128ull * 1024 * 1024;
+        static constexpr usz CommitSize = 64ull * 1024;
+        static constexpr usz GuardSize  = 64ull * 1024;
+
+        struct Registry
+        {
+            std::mutex                mutex;
+            std::vector<ThreadStack*> stacks;
+            usz                       retired_high_water = 0;
+        };
+
+        static Registry& GetRegistry()
+        {
+            return LeakedInstance<Registry>();
+        }
 
     public:
         ThreadStack()
-            : ptr(static_cast<std::byte *>(AllocVirtual(AllocationType::Commit | AllocationType::Reserve, StackSize)))
+            : ptr(static_cast<std::byte*>(AllocVirtual(AllocationType::Reserve, StackSize + GuardSize)))
+            , committed(ptr)
             , beg(ptr)
             , end(ptr + StackSize)
-        {}
+            , thread(std::this_thread::get_id())
+            , high_water(ptr)
+        {
+            if (!beg) {
+                NOVA_THROW("Failed to reserve thread stack");
+            }
+
+            auto& registry = GetRegistry();
+            std::scoped_lock lock{registry.mutex};
+            registry.stacks.push_back(this);
+        }
 
         ~ThreadStack()
         {
-            FreeVirtual(FreeType::Decommit, ptr);
+            {
+                auto& registry = GetRegistry();
+                std::scoped_lock lock{registry.mutex};
+                std::erase(registry.stacks, this);
+                registry.retired_high_water = std::max(registry.retired_high_water, GetHighWater());
+            }
+
+            FreeVirtual(FreeType::Release, beg);
         }
 
         size_t RemainingBytes()
         {
             return size_t(end - ptr);
         }
+
+        usz GetHighWater() const noexcept
+        {
+            return usz(std::max(high_water.load(std::memory_order_relaxed), ptr) - beg);
+        }
+
+        NOVA_FORCE_INLINE
+        void Rewind(std::byte* to) noexcept
+        {
+            if (ptr > high_water.load(std::memory_order_relaxed)) {
+                high_water.store(ptr, std::memory_order_relaxed);
+            }
+            ptr = to;
+        }
+
+        NOVA_NO_INLINE
+        void Grow(std::byte* target)
+        {
+            if (target > end) {
+                NOVA_THROW("Thread stack overflow, {} requested with {} of {} in use",
+                    ByteSizeToString(usz(target - ptr)), ByteSizeToString(usz(ptr - beg)), ByteSizeToString(StackSize));
+            }
+
+            auto* new_committed = std::min(AlignUpPower2(target, CommitSize), end);
+            if (!AllocVirtual(AllocationType::Commit, usz(new_committed - committed), committed)) {
+                NOVA_THROW("Failed to commit {} of thread stack", ByteSizeToString(usz(new_committed - committed)));
+            }
+            committed = new_committed;
+            committed_bytes.store(usz(committed - beg), std::memory_order_relaxed);
+        }
     };
 
     NOVA_FORCE_INLINE
@@ -1767,7 +3642,7 @@ namespace nova::detail
 
         ~ThreadStackPoint() noexcept
         {
-            GetThreadStack().ptr = ptr;
+            GetThreadStack().Rewind(ptr);
         }
 
         ThreadStackPoint(const ThreadStackPoint&) = delete;
@@ -1780,15 +3655,98 @@ namespace nova::detail
     T* StackAlloc(usz count)
     {
         auto& stack = GetThreadStack();
+        // Checked before the end pointer is formed, so that huge counts cannot wrap past the guard region
+        if (count > usz(stack.end - stack.ptr) / sizeof(T)) [[unlikely]] {
+            NOVA_THROW("Thread stack overflow, {} elements of {} requested with {} of {} in use",
+                count, ByteSizeToString(sizeof(T)), ByteSizeToString(usz(stack.ptr - stack.beg)), ByteSizeToString(ThreadStack::StackSize));
+        }
         T* ptr = reinterpret_cast<T*>(stack.ptr);
-        stack.ptr = AlignUpPower2(stack.ptr + sizeof(T) * count, 16);
+        std::byte* next = AlignUpPower2(stack.ptr + sizeof(T) * count, 16);
+        if (next > stack.committed) [[unlikely]] {
+            stack.Grow(next);
+        }
+        stack.ptr = next;
         return ptr;
     }
 }
 
+namespace nova
+{
+    // Returns stack usage for every live thread that has touched its thread stack, plus a single entry with a default
+    // thread id holding the largest high-water mark of exited threads. High-water marks are as of each thread's most
+    // recent stack rewind, so allocations still in scope on other threads are not included.
+    inline
+    std::vector<ThreadStackUsage> GetThreadStackUsage()
+    {
+        auto& registry = detail::ThreadStack::GetRegistry();
+        std::scoped_lock lock{registry.mutex};
+
+        std::vector<ThreadStackUsage> usage;
+        usage.reserve(registry.stacks.size() + 1);
+        if (registry.retired_high_water) {
+            usage.push_back({ {}, registry.retired_high_water, 0 });
+        }
+        for (auto* stack : registry.stacks) {
+            usage.push_back({
+                .thread = stack->thread,
+                .high_water = usz(stack->high_water.load(std::memory_order_relaxed) - stack->beg),
+                .committed = stack->committed_bytes.load(std::memory_order_relaxed),
+            });
+        }
+        return usage;
+    }
+}
+
 #define NOVA_STACK_POINT()            ::nova::detail::ThreadStackPoint NOVA_UNIQUE_VAR()
 #define NOVA_STACK_ALLOC(type, count) ::nova::detail::StackAlloc<type>(count)
 
+namespace nova::detail
+{
+    // Converts into the thread stack, then trims the allocation to the converted length. The result is null
+    // terminated and lives until the enclosing NOVA_STACK_POINT
+
+    template<typename OutT, typename InT, typename Fn>
+    BasicStringView<OutT> StackConvert(BasicStringView<InT> source, usz max_length, Fn&& convert)
+    {
+        auto& stack = GetThreadStack();
+        OutT* output = StackAlloc<OutT>(max_length + 1);
+        usz length = convert(source, output);
+        output[length] = OutT(0);
+        // Rewind records the worst case allocation in the high-water mark before trimming it
+        stack.Rewind(AlignUpPower2(reinterpret_cast<std::byte*>(output + length + 1), 16));
+        return { output, length + 1 };
+    }
+
+    inline
+    BasicStringView<wchar_t> StackToUtf16(StringView source)
+    {
+        return StackConvert<wchar_t>(source, source.Size(), [](StringView s, wchar_t* o) { return ToUtf16(s, o); });
+    }
+
+    inline
+    BasicStringView<c32> StackToUtf32(StringView source)
+    {
+        return StackConvert<c32>(source, source.Size(), [](StringView s, c32* o) { return ToUtf32(s, o); });
+    }
+
+    inline
+    StringView StackFromUtf16(BasicStringView<wchar_t> source)
+    {
+        return StackConvert<char>(source, source.Size() * 3, [](BasicStringView<wchar_t> s, char* o) { return FromUtf16(s, o); });
+    }
+
+    inline
+    StringView StackFromUtf32(BasicStringView<c32> source)
+    {
+        return StackConvert<char>(source, source.Size() * 4, [](BasicStringView<c32> s, char* o) { return FromUtf32(s, o); });
+    }
+}
+
+#define NOVA_STACK_TO_UTF16(str)   ::nova::detail::StackToUtf16(str)
+#define NOVA_STACK_TO_UTF32(str)   ::nova::detail::StackToUtf32(str)
+#define NOVA_STACK_FROM_UTF16(str) ::nova::detail::StackFromUtf16(str)
+#define NOVA_STACK_FROM_UTF32(str) ::nova::detail::StackFromUtf32(str)
+
 // -----------------------------------------------------------------------------
 //                         Reference Counting Pointer
 // -----------------------------------------------------------------------------
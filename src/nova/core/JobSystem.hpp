@@ -1,33 +1,260 @@
 #pragma once
 
 #include "Core.hpp"
+#include "JobTrace.hpp"
+#include "Profile.hpp"
 
+#include <coroutine>
 #include <deque>
 #include <shared_mutex>
 
 namespace nova
 {
     struct Job;
+    struct JobSystem;
+
+    // Jobs are taken strictly in priority order, background jobs only run when nothing else is queued
+    enum class JobPriority : u32
+    {
+        Critical,
+        Normal,
+        Background,
+    };
+
+    inline constexpr u32 JobPriorityCount = 3;
+
+// -----------------------------------------------------------------------------
+//                          Job allocation helpers
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        // Heap allocations made on behalf of jobs by any job system in the process: pool refills, overflowing
+        // signal lists and tasks too large for inline storage
+        inline std::atomic<u64> JobHeapAllocationCount = 0;
+
+        // Fixed size block pool with per-thread free lists.
+        //
+        // Blocks are freed to the local list of whichever thread drops the last reference, which for jobs is
+        // usually a worker rather than the submitting thread. Lists that grow past a threshold hand a batch
+        // back to a shared list that allocating threads refill from, so memory circulates between producers
+        // and consumers instead of piling up. Blocks are never returned to the system.
+
+        template<usz Size, usz Align>
+        class BlockPool
+        {
+            static constexpr u32 BatchSize = 64;
+
+            struct Block
+            {
+                Block* next;
+            };
+
+            struct Shared
+            {
+                std::mutex          mutex;
+                std::vector<Block*> batches;
+            };
+
+            static Shared& GetShared()
+            {
+                // Threads exiting during shutdown return their cached blocks here
+                return LeakedInstance<Shared>();
+            }
+
+            struct Cache
+            {
+                Block* head = nullptr;
+                u32   count = 0;
+
+                ~Cache()
+                {
+                    if (head) {
+                        auto& shared = GetShared();
+                        std::scoped_lock lock{shared.mutex};
+                        shared.batches.push_back(head);
+                    }
+                }
+            };
+
+            static inline thread_local Cache cache;
+
+        public:
+            static void* Allocate()
+            {
+                auto& local = cache;
+                if (!local.head) {
+                    auto& shared = GetShared();
+                    std::scoped_lock lock{shared.mutex};
+                    if (!shared.batches.empty()) {
+                        local.head = shared.batches.back();
+                        shared.batches.pop_back();
+                        local.count = BatchSize;
+                    }
+                }
+
+                if (Block* block = local.head) {
+                    local.head = block->next;
+                    local.count = local.count ? local.count - 1 : 0;
+                    return block;
+                }
+
+                JobHeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(std::max(Size, sizeof(Block)), std::align_val_t(std::max(Align, alignof(Block))));
+            }
+
+            static void Free(void* ptr)
+            {
+                auto& local = cache;
+                auto* block = static_cast<Block*>(ptr);
+                block->next = local.head;
+                local.head = block;
+
+                if (++local.count >= BatchSize * 2) {
+                    // Split off a batch and hand it back to the shared list
+                    Block* batch = local.head;
+                    Block* tail = batch;
+                    for (u32 i = 1; i < BatchSize; ++i) {
+                        tail = tail->next;
+                    }
+                    local.head = tail->next;
+                    local.count -= BatchSize;
+                    tail->next = nullptr;
+
+                    auto& shared = GetShared();
+                    std::scoped_lock lock{shared.mutex};
+                    shared.batches.push_back(batch);
+                }
+            }
+        };
+
+        // Append only array with inline storage for the first N elements, only allocates on overflow
+
+        template<typename T, u32 N>
+        class InlineArray
+        {
+            T*     data;
+            u32   count = 0;
+            u32 capacity = N;
+            alignas(T) std::byte storage[N * sizeof(T)];
+
+            bool IsInline() const noexcept { return data == reinterpret_cast<const T*>(storage); }
+
+            void Grow()
+            {
+                JobHeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+                u32 new_capacity = capacity * 2;
+                T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T), std::align_val_t(alignof(T))));
+                for (u32 i = 0; i < count; ++i) {
+                    new (new_data + i) T(std::move(data[i]));
+                    data[i].~T();
+                }
+                if (!IsInline()) {
+                    ::operator delete(data, std::align_val_t(alignof(T)));
+                }
+                data = new_data;
+                capacity = new_capacity;
+            }
+
+        public:
+            InlineArray() noexcept
+                : data(reinterpret_cast<T*>(storage))
+            {}
+
+            InlineArray(const InlineArray&) = delete;
+            auto operator=(const InlineArray&) = delete;
+
+            ~InlineArray()
+            {
+                clear();
+                if (!IsInline()) {
+                    ::operator delete(data, std::align_val_t(alignof(T)));
+                }
+            }
+
+            template<typename... Args>
+            T& emplace_back(Args&&... args)
+            {
+                if (count == capacity) {
+                    Grow();
+                }
+                return *new (data + count++) T(std::forward<Args>(args)...);
+            }
+
+            void push_back(T value)
+            {
+                emplace_back(std::move(value));
+            }
+
+            void clear() noexcept
+            {
+                for (u32 i = 0; i < count; ++i) {
+                    data[i].~T();
+                }
+                count = 0;
+            }
+
+            T* begin() noexcept { return data; }
+            T*   end() noexcept { return data + count; }
+
+            const T* begin() const noexcept { return data; }
+            const T*   end() const noexcept { return data + count; }
+
+            u32      size() const noexcept { return count; }
+            bool    empty() const noexcept { return count == 0; }
+            T& operator[](u32 index) noexcept { return data[index]; }
+        };
+
+        // Suspended coroutine waiting on a Barrier, stored intrusively in the awaiting coroutine frame
+        struct BarrierContinuation
+        {
+            JobSystem*                   system = nullptr;
+            std::coroutine_handle<>      handle;
+            BarrierContinuation*           next = nullptr;
+        };
+
+        // Worker sleeping in WaitHelping on a Barrier, stored intrusively on the helping worker's stack
+        struct BarrierHelper
+        {
+            JobSystem*             system = nullptr;
+            BarrierHelper*           next = nullptr;
+        };
+    }
 
     struct Barrier : RefCounted
     {
-        std::atomic<u32>      counter = 0;
-        u32                  acquired = 0;
-        std::vector<Ref<Job>> pending;
-
-        // void Signal()
-        // {
-        //     if (--counter == 0)
-        //     {
-        //         for (auto& task : pending)
-        //         {
-        //             task->system->Submit(task);
-        //         }
-        //         counter.notify_all();
-        //     }
-        // }
-
-        void Wait()
+        std::atomic<u32>                       counter = 0;
+        u32                                   acquired = 0;
+        detail::InlineArray<Ref<Job>, 2>       pending;
+
+        // Coroutines suspended on this barrier, resumed on their job system when signalled
+        std::mutex                     continuation_mutex;
+        detail::BarrierContinuation* continuations = nullptr;
+
+        // Worker threads sleeping while waiting on this barrier, each woken on its own job system when signalled.
+        // Guarded by continuation_mutex, helping is checked first so that signalling skips the lock when empty
+        std::atomic<u32>             helping = 0;
+        detail::BarrierHelper*       helpers = nullptr;
+
+        void Signal();
+
+        // Registers a continuation to resume once signalled, returns false if the barrier is already signalled
+        bool Suspend(detail::BarrierContinuation& continuation)
+        {
+            std::scoped_lock lock{continuation_mutex};
+            if (counter.load() == 0) {
+                return false;
+            }
+            continuation.next = continuations;
+            continuations = &continuation;
+            return true;
+        }
+
+        // On worker threads this executes other queued jobs until the barrier is signalled, so nested
+        // fork/join does not starve the pool. Other threads block.
+        void Wait();
+
+        void WaitBlocking()
         {
             u32 v = counter.load();
             while (v != 0) {
@@ -53,24 +280,77 @@ namespace nova
         {
             return new Barrier();
         }
-    };
 
-    struct JobSystem;
+        static void* operator new(usz size)
+        {
+            NOVA_ASSERT(size == sizeof(Barrier), "Unexpected Barrier allocation size");
+            return detail::BlockPool<sizeof(Barrier), alignof(Barrier)>::Allocate();
+        }
+
+        static void operator delete(void* ptr)
+        {
+            detail::BlockPool<sizeof(Barrier), alignof(Barrier)>::Free(ptr);
+        }
+    };
 
     struct Job : RefCounted
     {
-        JobSystem*                 system = {};
-        std::function<void()>        task;
-        std::vector<Ref<Barrier>> signals;
+        JobSystem*                               system = {};
+        Function<void()>                           task;
+        detail::InlineArray<Ref<Barrier>, 2>    signals;
+        JobPriority                   priority = JobPriority::Normal;
+        bool                                io = false;
+
+        // Tracing only
+        const char*                         name = nullptr;
+        u64                               queued = 0;
 
-        static Ref<Job> Create(JobSystem* system, std::function<void()> task)
+        template<typename Fn>
+        static Ref<Job> Create(JobSystem* system, Fn&& task)
         {
+            if constexpr (!decltype(Job::task)::template FitsInline<Fn>) {
+                detail::JobHeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
             Ref job = new Job();
             job->system = system;
-            job->task = std::move(task);
+            job->task = std::forward<Fn>(task);
             return job;
         }
 
+        // Jobs are recycled through per-thread free lists instead of hitting the general allocator
+
+        static void* operator new(usz size)
+        {
+            NOVA_ASSERT(size == sizeof(Job), "Unexpected Job allocation size");
+            return detail::BlockPool<sizeof(Job), alignof(Job)>::Allocate();
+        }
+
+        static void operator delete(void* ptr)
+        {
+            detail::BlockPool<sizeof(Job), alignof(Job)>::Free(ptr);
+        }
+
+        Ref<Job> Priority(JobPriority _priority)
+        {
+            priority = _priority;
+            return this;
+        }
+
+        // Label shown for this job in traces, must outlive the job
+        Ref<Job> Name(const char* _name)
+        {
+            name = _name;
+            return this;
+        }
+
+        // Marks the job as blocking (file, network or database access), to run on the I/O workers
+        Ref<Job> IO()
+        {
+            io = true;
+            return this;
+        }
+
         Ref<Job> Signal(Ref<Barrier> signal)
         {
             if (signal->acquired > 0) {
@@ -85,42 +365,250 @@ namespace nova
         void Submit();
     };
 
+// -----------------------------------------------------------------------------
+//                           Work stealing deque
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        // Chase-Lev deque, using the C11 memory orderings from
+        //   "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013)
+        //
+        // The owning thread pushes and pops at the bottom, any other thread may steal from the top.
+        // Retired rings are kept alive until the deque is destroyed as thieves may still be reading them.
+
+        template<typename T>
+        class WorkStealingDeque
+        {
+            struct Ring
+            {
+                i64                                 mask;
+                std::unique_ptr<std::atomic<T*>[]> items;
+
+                Ring(i64 capacity)
+                    : mask(capacity - 1)
+                    , items(new std::atomic<T*>[usz(capacity)])
+                {}
+
+                i64 Capacity() const noexcept { return mask + 1; }
+
+                // Release/acquire on the slots themselves publishes the item contents independently of the fences,
+                // which is free on x86 and keeps thread sanitizers aware of the hand-off
+                T*   Load(i64 index) const noexcept { return items[index & mask].load(std::memory_order_acquire); }
+                void Store(i64 index, T* item) noexcept { items[index & mask].store(item, std::memory_order_release); }
+            };
+
+            alignas(64) std::atomic<i64>    top = 0;
+            alignas(64) std::atomic<i64> bottom = 0;
+            std::atomic<Ring*>                 ring;
+            std::vector<std::unique_ptr<Ring>> rings;
+
+        public:
+            WorkStealingDeque(i64 capacity = 256)
+            {
+                ring.store(rings.emplace_back(new Ring(capacity)).get(), std::memory_order_relaxed);
+            }
+
+            WorkStealingDeque(const WorkStealingDeque&) = delete;
+            auto operator=(const WorkStealingDeque&) = delete;
+
+            // Owner only
+            void Push(T* item)
+            {
+                i64 b = bottom.load(std::memory_order_relaxed);
+                i64 t = top.load(std::memory_order_acquire);
+                Ring* r = ring.load(std::memory_order_relaxed);
+
+                if (b - t > r->mask) {
+                    auto* grown = rings.emplace_back(new Ring(r->Capacity() * 2)).get();
+                    for (i64 i = t; i < b; ++i) {
+                        grown->Store(i, r->Load(i));
+                    }
+                    ring.store(grown, std::memory_order_release);
+                    r = grown;
+                }
+
+                r->Store(b, item);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            // Owner only
+            T* Pop()
+            {
+                i64 b = bottom.load(std::memory_order_relaxed) - 1;
+                Ring* r = ring.load(std::memory_order_relaxed);
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 t = top.load(std::memory_order_relaxed);
+
+                if (t > b) {
+                    // Empty
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                T* item = r->Load(b);
+                if (t == b) {
+                    // Last item, race against thieves
+                    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                        item = nullptr;
+                    }
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                }
+
+                return item;
+            }
+
+            // Any thread
+            T* Steal()
+            {
+                i64 t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                i64 b = bottom.load(std::memory_order_acquire);
+
+                if (t >= b) {
+                    return nullptr;
+                }
+
+                T* item = ring.load(std::memory_order_acquire)->Load(t);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    // Lost race against another thief or the owner
+                    return nullptr;
+                }
+
+                return item;
+            }
+
+            // Approximate, may be stale by the time it is read
+            usz Size() const noexcept
+            {
+                i64 b = bottom.load(std::memory_order_relaxed);
+                i64 t = top.load(std::memory_order_relaxed);
+                return usz(std::max(b - t, i64(0)));
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+//                               Job System
+// -----------------------------------------------------------------------------
+
     struct WorkerState
     {
-        u32 worker_id = ~0u;
+        JobSystem* system = nullptr;
+        u32     worker_id = ~0u;
     };
 
     inline thread_local WorkerState JobWorkerState;
 
+    struct JobSystemStats
+    {
+        // Approximate number of queued jobs per priority, may be stale by the time it is read
+        std::array<usz, JobPriorityCount>    queued = {};
+        std::array<usz, JobPriorityCount> io_queued = {};
+
+        u32    workers = 0;
+        u32 io_workers = 0;
+        u32   sleeping = 0;
+    };
+
     struct JobSystem
     {
-        std::vector<std::jthread> workers;
-        std::deque<Ref<Job>>        queue;
-        std::shared_mutex           mutex;
-        std::condition_variable_any    cv;
+        struct WorkerQueue
+        {
+            struct Level
+            {
+                detail::WorkStealingDeque<Job> deque;
+
+                // Most recent front submission, run before anything else in the local deque
+                alignas(64) std::atomic<Job*> next = nullptr;
+            };
+
+            std::array<Level, JobPriorityCount> levels;
+
+            u64 rng;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::jthread>                workers;
+
+        // Submissions from threads outside of this job system
+        std::array<std::deque<Job*>, JobPriorityCount>       injected;
+        std::mutex                                     injected_mutex;
+        std::array<std::atomic<usz>, JobPriorityCount> injected_count = {};
+
+        alignas(64) std::atomic<u32> sleeping = 0;
+        alignas(64) std::atomic<u32>    epoch = 0;
+
+        // Blocking jobs run on a separate set of threads so they can never starve compute workers
+        std::vector<std::jthread>                          io_workers;
+        std::array<std::deque<Job*>, JobPriorityCount>      io_queued;
+        std::mutex                                           io_mutex;
+        std::condition_variable                                 io_cv;
+
+        // Coroutines waiting on a condition that nothing signals (e.g. a gpu fence). One idle worker at a time
+        // keeps rechecking them instead of going to sleep
+        struct ParkedPoll
+        {
+            bool(*check)(const void*);
+            const void*      pollable;
+            std::coroutine_handle<> handle;
+        };
+
+        std::vector<ParkedPoll>       parked;
+        std::mutex              parked_mutex;
+        std::atomic<usz>        parked_count = 0;
+        std::atomic<bool>            polling = false;
 
-        bool running = true;
+        std::atomic<bool> running = true;
 
     public:
-        JobSystem(u32 threads)
+        JobSystem(u32 threads, u32 io_threads = 0)
         {
+            queues.reserve(threads);
+            for (u32 i = 0; i < threads; ++i) {
+                auto& queue = queues.emplace_back(new WorkerQueue);
+                queue->rng = hash::Mix(u64(i) + 1, u64(uintptr_t(this)));
+            }
+
+            workers.reserve(threads);
             for (u32 i = 0; i < threads; ++i) {
                 workers.emplace_back([this, i] {
                     Worker(this, i);
                 });
             }
+
+            io_workers.reserve(io_threads);
+            for (u32 i = 0; i < io_threads; ++i) {
+                io_workers.emplace_back([this, i] {
+                    IOWorker(i);
+                });
+            }
         }
 
         ~JobSystem()
         {
             Shutdown();
+            workers.clear();
+            io_workers.clear();
         }
 
         void Shutdown()
         {
-            std::scoped_lock lock{mutex};
             running = false;
-            cv.notify_all();
+            epoch++;
+            epoch.notify_all();
+
+            std::scoped_lock lock{io_mutex};
+            io_cv.notify_all();
+        }
+
+        // Process wide job system, shared by the parallel algorithms so that there is only one pool per process
+        static JobSystem& GetDefault()
+        {
+            static JobSystem system(std::max(2u, std::thread::hardware_concurrency()) - 1, 2);
+            return system;
         }
 
         static u32 GetWorkerID() noexcept
@@ -128,62 +616,558 @@ namespace nova
             return JobWorkerState.worker_id;
         }
 
+        u32 GetWorkerCount() const noexcept
+        {
+            return u32(queues.size());
+        }
+
+        u32 GetIOWorkerCount() const noexcept
+        {
+            return u32(io_workers.size());
+        }
+
+        bool IsWorkerThread() const noexcept
+        {
+            return JobWorkerState.system == this;
+        }
+
+        JobSystemStats GetStats()
+        {
+            JobSystemStats stats;
+            stats.workers = GetWorkerCount();
+            stats.io_workers = GetIOWorkerCount();
+            stats.sleeping = sleeping.load(std::memory_order_relaxed);
+
+            for (u32 p = 0; p < JobPriorityCount; ++p) {
+                stats.queued[p] = injected_count[p].load(std::memory_order_relaxed);
+                for (auto& queue : queues) {
+                    auto& level = queue->levels[p];
+                    stats.queued[p] += level.deque.Size();
+                    stats.queued[p] += level.next.load(std::memory_order_relaxed) ? 1 : 0;
+                }
+            }
+
+            {
+                std::scoped_lock lock{io_mutex};
+                for (u32 p = 0; p < JobPriorityCount; ++p) {
+                    stats.io_queued[p] = io_queued[p].size();
+                }
+            }
+
+            return stats;
+        }
+
+        // Total heap allocations made for jobs across all job systems, see detail::JobHeapAllocationCount
+        static u64 GetHeapAllocationCount() noexcept
+        {
+            return detail::JobHeapAllocationCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static Job* Detach(Ref<Job>& job)
+        {
+            // Queued jobs hold a single reference through a raw pointer
+            Job* raw = job.Raw();
+            raw->RefCounted_Acquire();
+            return raw;
+        }
+
+        static Ref<Job> Adopt(Job* raw)
+        {
+            Ref<Job> job = raw;
+            raw->RefCounted_Release();
+            return job;
+        }
+
+        Job* PopInjected(u32 priority)
+        {
+            if (injected_count[priority].load(std::memory_order_relaxed) == 0) {
+                return nullptr;
+            }
+
+            std::scoped_lock lock{injected_mutex};
+            auto& queue = injected[priority];
+            if (queue.empty()) {
+                return nullptr;
+            }
+
+            Job* raw = queue.front();
+            queue.pop_front();
+            injected_count[priority]--;
+            return raw;
+        }
+
+        static Job* Stolen(Job* job, u32 victim)
+        {
+            if (JobTrace::IsEnabled()) [[unlikely]] {
+                JobTrace::Record({ .type = JobTraceEvent::Type::Steal, .arg = victim, .begin = JobTrace::Now() });
+            }
+            return job;
+        }
+
+        Job* StealFrom(u32 thief, u32 priority)
+        {
+            u32 count = u32(queues.size());
+            if (count <= 1) {
+                return nullptr;
+            }
+
+            // xorshift64 for a random starting victim
+            u64& rng = queues[thief]->rng;
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+
+            u32 start = u32(rng % count);
+            for (u32 i = 0; i < count; ++i) {
+                u32 victim = (start + i) % count;
+                if (victim == thief) {
+                    continue;
+                }
+
+                auto& level = queues[victim]->levels[priority];
+                if (Job* job = level.deque.Steal()) {
+                    return Stolen(job, victim);
+                }
+
+                if (level.next.load(std::memory_order_relaxed)) {
+                    if (Job* job = level.next.exchange(nullptr)) {
+                        return Stolen(job, victim);
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        Job* FindJob(u32 index)
+        {
+            // Higher priorities are exhausted everywhere (locally, injected, other workers) before lower ones
+            auto& queue = *queues[index];
+
+            for (u32 p = 0; p < JobPriorityCount; ++p) {
+                auto& level = queue.levels[p];
+
+                if (level.next.load(std::memory_order_relaxed)) {
+                    if (Job* job = level.next.exchange(nullptr)) {
+                        return job;
+                    }
+                }
+
+                if (Job* job = level.deque.Pop())   return job;
+                if (Job* job = PopInjected(p))       return job;
+                if (Job* job = StealFrom(index, p))  return job;
+            }
+
+            return nullptr;
+        }
+
+        // Queue entries are either jobs holding a single reference, or suspended coroutines tagged in the low bit
+        static Job* Tag(std::coroutine_handle<> handle)
+        {
+            return reinterpret_cast<Job*>(uintptr_t(handle.address()) | 1);
+        }
+
+        void Execute(Job* raw)
+        {
+            if (JobTrace::IsEnabled()) [[unlikely]] {
+                ExecuteTraced(raw);
+            } else {
+                Run(raw);
+            }
+        }
+
+        NOVA_NO_INLINE void ExecuteTraced(Job* raw)
+        {
+            JobTraceEvent event{ .type = JobTraceEvent::Type::Resume };
+            if (!(uintptr_t(raw) & 1)) {
+                event.type = JobTraceEvent::Type::Job;
+                event.arg = u32(raw->priority);
+                event.name = raw->name;
+                event.queued = raw->queued;
+            }
+
+            event.begin = JobTrace::Now();
+            Run(raw, &event);
+        }
+
+        void Run(Job* raw, JobTraceEvent* event = nullptr)
+        {
+            if (uintptr_t(raw) & 1) {
+                std::coroutine_handle<>::from_address(reinterpret_cast<void*>(uintptr_t(raw) & ~uintptr_t(1))).resume();
+                if (event) {
+                    event->end = JobTrace::Now();
+                    JobTrace::Record(*event);
+                }
+                return;
+            }
+
+            auto job = Adopt(raw);
+
+            // run job
+            job->task();
+
+            if (event) {
+                // Record before signalling, so anyone waiting on the job also observes its trace event
+                event->end = JobTrace::Now();
+                JobTrace::Record(*event);
+            }
+
+            for (auto& signal : job->signals) {
+                signal->Signal();
+            }
+        }
+
+        void Enqueue(Job* raw, bool front, JobPriority priority)
+        {
+            if (IsWorkerThread()) {
+                // Local submissions go to the current worker and are stolen by others when idle.
+                // Front submissions (e.g. Barrier continuations) take the next slot for LIFO priority
+                auto& level = queues[JobWorkerState.worker_id]->levels[u32(priority)];
+                if (front) {
+                    if (Job* prev = level.next.exchange(raw)) {
+                        level.deque.Push(prev);
+                    }
+                } else {
+                    level.deque.Push(raw);
+                }
+            } else {
+                Inject(raw, front, priority);
+                return;
+            }
+
+            Wake();
+        }
+
+        void Inject(Job* raw, bool front, JobPriority priority)
+        {
+            {
+                std::scoped_lock lock{injected_mutex};
+                auto& queue = injected[u32(priority)];
+                if (front) {
+                    queue.push_front(raw);
+                } else {
+                    queue.push_back(raw);
+                }
+                injected_count[u32(priority)]++;
+            }
+
+            Wake();
+        }
+
+        void EnqueueIO(Job* raw, bool front, JobPriority priority)
+        {
+            std::scoped_lock lock{io_mutex};
+            auto& queue = io_queued[u32(priority)];
+            if (front) {
+                queue.push_front(raw);
+            } else {
+                queue.push_back(raw);
+            }
+            io_cv.notify_one();
+        }
+
+    public:
+        // Wakes every sleeping worker and helping waiter
+        void WakeAll()
+        {
+            epoch++;
+            epoch.notify_all();
+        }
+
+    private:
+        void Wake()
+        {
+            // Pairs with the fence in Worker, either the sleeper sees the new job or we see the sleeper
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping.load(std::memory_order_relaxed) > 0) {
+                epoch++;
+                epoch.notify_one();
+            }
+        }
+
+    public:
         void Worker([[maybe_unused]] JobSystem* system, u32 index)
         {
-            JobWorkerState.worker_id = index;
-            NOVA_DEFER() { JobWorkerState.worker_id = ~0u; };
+            JobWorkerState = { this, index };
+            NOVA_DEFER() { JobWorkerState = {}; };
+            SetTraceThreadName(Fmt("Worker {}", index));
 
             for (;;) {
-                // Acquire a lock
-                std::unique_lock lock{mutex};
+                Job* job = FindJob(index);
+
+                if (!job && parked_count.load(std::memory_order_relaxed) && !polling.exchange(true, std::memory_order_acquire)) {
+                    job = PollUntilJob(index);
+                }
 
-                // Wait while the queue is empty
-                while (queue.empty()) {
-                    if (!running) {
-                        return;
+                if (!job) {
+                    // Announce intent to sleep, then check once more for work before waiting
+                    sleeping++;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    u32 last_epoch = epoch.load();
+
+                    job = FindJob(index);
+                    if (!job) {
+                        if (!running) {
+                            sleeping--;
+                            return;
+                        }
+                        // Parked coroutines are never signalled, so stay up to take over polling if nobody is
+                        if (!parked_count.load(std::memory_order_relaxed) || polling.load(std::memory_order_relaxed)) {
+                            epoch.wait(last_epoch);
+                        }
+                        sleeping--;
+                        continue;
                     }
-                    cv.wait(lock); // Wait for cv.notify_one() that signals a job has been added
+
+                    sleeping--;
+                }
+
+                Execute(job);
+            }
+        }
+
+    private:
+        // Rechecks parked coroutines until a job turns up or nothing is left parked. Called by the one worker
+        // that won the polling flag, which it hands to a sleeping worker if it leaves to run a job
+        Job* PollUntilJob(u32 index)
+        {
+            Job* job = nullptr;
+            for (u32 attempt = 0; running && parked_count.load(std::memory_order_relaxed); ++attempt) {
+                PollParked();
+                if ((job = FindJob(index))) {
+                    break;
+                }
+
+                // Back off once the parked conditions stay unmet, other workers are still woken for new jobs
+                if (attempt < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
                 }
+            }
 
-                // Pop from the queue (while owning the lock)
-                auto job = queue.front();
-                queue.pop_front();
+            polling.store(false, std::memory_order_release);
+            if (job && parked_count.load(std::memory_order_relaxed)) {
+                Wake();
+            }
+            return job;
+        }
 
-                // unlock
-                lock.unlock();
+        void PollParked()
+        {
+            std::scoped_lock lock{parked_mutex};
+            std::erase_if(parked, [&](const ParkedPoll& poll) {
+                if (!poll.check(poll.pollable)) {
+                    return false;
+                }
+                Enqueue(Tag(poll.handle), false, JobPriority::Normal);
+                return true;
+            });
+            parked_count.store(parked.size(), std::memory_order_relaxed);
+        }
 
-                // run job
-                job->task();
+    public:
+        // I/O workers are not registered as workers of this system. Anything they submit goes through the
+        // injection queue, and barrier waits on them block instead of helping with compute jobs.
+        void IOWorker(u32 index)
+        {
+            SetTraceThreadName(Fmt("I/O Worker {}", index));
 
-                for (auto& signal : job->signals) {
-                    // signal->Signal();
-                    // Log("Signalling, counter = {}", signal->counter.load());
-                    if (--signal->counter == 0) {
-                        // Log("  Reached 0!");
-                        for (auto& task : signal->pending) {
-                            task->system->Submit(task, true);
+            for (;;) {
+                Job* job = nullptr;
+                {
+                    std::unique_lock lock{io_mutex};
+                    for (;;) {
+                        for (auto& queue : io_queued) {
+                            if (!queue.empty()) {
+                                job = queue.front();
+                                queue.pop_front();
+                                break;
+                            }
+                        }
+
+                        if (job) {
+                            break;
                         }
-                        signal->counter.notify_all();
+
+                        if (!running) {
+                            return;
+                        }
+
+                        io_cv.wait(lock);
                     }
                 }
+
+                Execute(job);
             }
         }
 
+        // Executes queued jobs on the current worker until the barrier is signalled, sleeping alongside
+        // idle workers when no work can be found. Helpers are woken by whoever signals the barrier.
+        void WaitHelping(Barrier& barrier)
+        {
+            u32 index = JobWorkerState.worker_id;
+
+            while (barrier.counter.load(std::memory_order_acquire) != 0) {
+                Job* job = FindJob(index);
+
+                if (!job) {
+                    detail::BarrierHelper helper{ .system = this };
+                    {
+                        std::scoped_lock lock{barrier.continuation_mutex};
+                        helper.next = std::exchange(barrier.helpers, &helper);
+                    }
+
+                    sleeping++;
+                    barrier.helping++;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    u32 last_epoch = epoch.load();
+
+                    if (barrier.counter.load(std::memory_order_relaxed) != 0) {
+                        job = FindJob(index);
+                        if (!job) {
+                            epoch.wait(last_epoch);
+                        }
+                    }
+
+                    barrier.helping--;
+                    sleeping--;
+
+                    {
+                        std::scoped_lock lock{barrier.continuation_mutex};
+                        auto** link = &barrier.helpers;
+                        while (*link != &helper) {
+                            link = &(*link)->next;
+                        }
+                        *link = helper.next;
+                    }
+
+                    if (!job) {
+                        continue;
+                    }
+                }
+
+                Execute(job);
+            }
+        }
+
+        // I/O jobs fall back to the background priority of the compute workers if there are no I/O workers
         void Submit(Ref<Job> job, bool front = false)
         {
-            std::scoped_lock lock { mutex };
-            if (front) {
-                queue.push_front(std::move(job));
+            if (JobTrace::IsEnabled()) [[unlikely]] {
+                job->queued = JobTrace::Now();
+            }
+
+            JobPriority priority = job->priority;
+            if (job->io) {
+                if (!io_workers.empty()) {
+                    EnqueueIO(Detach(job), front, priority);
+                    return;
+                }
+                priority = JobPriority::Background;
+            }
+            Enqueue(Detach(job), front, priority);
+        }
+
+        // Resumes a suspended coroutine on this job system without allocating a Job
+        void Submit(std::coroutine_handle<> handle, bool front = false, JobPriority priority = JobPriority::Normal)
+        {
+            Enqueue(Tag(handle), front, priority);
+        }
+
+        // Resumes a suspended coroutine on an I/O worker, where it may block
+        void SubmitIO(std::coroutine_handle<> handle, JobPriority priority = JobPriority::Normal)
+        {
+            if (io_workers.empty()) {
+                Enqueue(Tag(handle), false, JobPriority::Background);
             } else {
-                queue.push_back(std::move(job));
+                EnqueueIO(Tag(handle), false, priority);
             }
-            cv.notify_one();
+        }
+
+        // Resumes a suspended coroutine after all currently queued local work, used to yield
+        void Yield(std::coroutine_handle<> handle)
+        {
+            Inject(Tag(handle), false, JobPriority::Normal);
+        }
+
+        // Resumes a suspended coroutine once check(pollable) returns true. The check runs on an idle worker,
+        // never while there are jobs to run, and pollable must stay valid until the coroutine is resumed
+        void Park(std::coroutine_handle<> handle, bool(*check)(const void*), const void* pollable)
+        {
+            {
+                std::scoped_lock lock{parked_mutex};
+                parked.push_back({ check, pollable, handle });
+                parked_count.store(parked.size(), std::memory_order_relaxed);
+            }
+
+            // Pairs with the sleep check in Worker, either a sleeper is woken to poll or it sees the parked count
+            Wake();
         }
     };
 
+    inline
+    void Barrier::Signal()
+    {
+        if (--counter != 0) {
+            return;
+        }
+
+        for (auto& task : pending) {
+            task->system->Submit(task, true);
+        }
+
+        detail::BarrierContinuation* resume;
+        {
+            std::scoped_lock lock{continuation_mutex};
+            resume = std::exchange(continuations, nullptr);
+        }
+
+        while (resume) {
+            // Read next first, the continuation is owned by the coroutine frame which may complete immediately
+            auto* next = resume->next;
+            resume->system->Submit(resume->handle, true);
+            resume = next;
+        }
+
+        counter.notify_all();
+
+        // Pairs with the fence in WaitHelping, either the helper sees the signal or we see the helper
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (helping.load(std::memory_order_relaxed) > 0) {
+            // Helpers may come from different job systems, wake each of them. Helpers unregister under the
+            // same lock before returning, so every node visited here is still alive
+            std::scoped_lock lock{continuation_mutex};
+            for (auto* helper = helpers; helper; helper = helper->next) {
+                helper->system->WakeAll();
+            }
+        }
+    }
+
+    inline
+    void Barrier::Wait()
+    {
+        auto WaitUntraced = [this] {
+            if (auto* system = JobWorkerState.system) {
+                system->WaitHelping(*this);
+            } else {
+                WaitBlocking();
+            }
+        };
+
+        if (JobTrace::IsEnabled()) [[unlikely]] {
+            u64 begin = JobTrace::Now();
+            WaitUntraced();
+            JobTrace::Record({ .type = JobTraceEvent::Type::BarrierWait, .begin = begin, .end = JobTrace::Now() });
+        } else {
+            WaitUntraced();
+        }
+    }
+
     inline
     void Job::Submit()
     {
         system->Submit(this);
     }
-}
\ No newline at end of file
+}
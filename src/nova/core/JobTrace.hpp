@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Trace.hpp"
+
+namespace nova
+{
+    struct JobTraceEvent
+    {
+        enum class Type : u32
+        {
+            Job,
+            Resume,
+            Steal,
+            BarrierWait,
+        };
+
+        Type        type;
+        u32          arg = 0; // Priority for jobs, victim worker for steals
+        const char* name = nullptr;
+        u64        begin = 0;
+        u64          end = 0;
+        u64       queued = 0; // Submission time for jobs, 0 if unknown
+    };
+
+// -----------------------------------------------------------------------------
+//                                Job Trace
+// -----------------------------------------------------------------------------
+
+    // Opt-in recording of job system activity.
+    //
+    // Every thread records into its own buffer of fixed size chunks. Only the owning thread writes, and
+    // publishes each event with a release store of the chunk count, so recording never takes a lock.
+    // Instrumentation points check IsEnabled() once, a relaxed load and a branch, when tracing is off.
+
+    class JobTrace
+    {
+        struct Chunk
+        {
+            static constexpr u32 Capacity = 4096;
+
+            std::array<JobTraceEvent, Capacity> events;
+            std::atomic<u32>                 count = 0;
+            std::atomic<Chunk*>               next = nullptr;
+        };
+
+        struct Buffer
+        {
+            std::string name;
+            u32          tid = 0;
+            Chunk*      head = new Chunk;
+            Chunk*      tail = head;
+
+            ~Buffer()
+            {
+                while (head) {
+                    delete std::exchange(head, head->next.load());
+                }
+            }
+        };
+
+        using Registry = detail::TraceBufferRegistry<Buffer>;
+
+        static inline std::atomic<bool> enabled = false;
+
+        template<typename Fn>
+        static void ForEachEvent(Buffer& buffer, Fn&& fn)
+        {
+            for (Chunk* chunk = buffer.head; chunk; chunk = chunk->next.load(std::memory_order_acquire)) {
+                u32 count = chunk->count.load(std::memory_order_acquire);
+                for (u32 i = 0; i < count; ++i) {
+                    fn(chunk->events[i]);
+                }
+            }
+        }
+
+    public:
+        static bool IsEnabled() noexcept
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        static void Enable(bool state = true) noexcept
+        {
+            enabled.store(state, std::memory_order_relaxed);
+        }
+
+        static u64 Now() noexcept
+        {
+            return TraceNow();
+        }
+
+        static void Record(const JobTraceEvent& event)
+        {
+            Buffer* buffer = Registry::AcquireLocal();
+
+            Chunk* chunk = buffer->tail;
+            u32 count = chunk->count.load(std::memory_order_relaxed);
+            if (count == Chunk::Capacity) {
+                auto* next = new Chunk;
+                chunk->next.store(next, std::memory_order_release);
+                buffer->tail = chunk = next;
+                count = 0;
+            }
+
+            chunk->events[count] = event;
+            chunk->count.store(count + 1, std::memory_order_release);
+        }
+
+        // Discards all recorded events, must not be called while any thread may be recording
+        static void Clear()
+        {
+            Registry::Get().ForEach([](Buffer& buffer) {
+                Chunk* chunk = buffer.head->next.exchange(nullptr);
+                while (chunk) {
+                    delete std::exchange(chunk, chunk->next.load());
+                }
+                buffer.head->count = 0;
+                buffer.tail = buffer.head;
+            });
+        }
+
+        // Writes all events recorded so far in the Chrome trace event format
+        static void WriteChromeTrace(JsonWriter& json)
+        {
+            auto& registry = Registry::Get();
+
+            u64 origin = UINT64_MAX;
+            registry.ForEach([&](Buffer& buffer) {
+                ForEachEvent(buffer, [&](const JobTraceEvent& event) {
+                    origin = std::min(origin, event.queued ? event.queued : event.begin);
+                });
+            });
+
+            ChromeTraceWriter writer{json, origin};
+            registry.ForEach([&](Buffer& buffer) {
+                writer.ThreadName(buffer.tid, buffer.name);
+
+                ForEachEvent(buffer, [&](const JobTraceEvent& event) {
+                    switch (event.type) {
+                        break;case JobTraceEvent::Type::Job:
+                            writer.BeginEvent(event.name ? event.name : "Job", "job", "X", buffer.tid, event.begin);
+                            json.Key("dur").Value(ChromeTraceWriter::Micros(event.end - event.begin));
+                            json.Key("args");
+                            json.Object();
+                            json["priority"] = event.arg;
+                            if (event.queued) {
+                                json.Key("queue_wait_us").Value(ChromeTraceWriter::Micros(event.begin - event.queued));
+                            }
+                            json.EndObject();
+                            writer.EndEvent();
+                        break;case JobTraceEvent::Type::Resume:
+                            writer.Complete("Resume", "coroutine", buffer.tid, event.begin, event.end);
+                        break;case JobTraceEvent::Type::Steal:
+                            writer.BeginEvent("Steal", "steal", "i", buffer.tid, event.begin);
+                            json["s"].String("t");
+                            json.Key("args");
+                            json.Object();
+                            json["victim"] = event.arg;
+                            json.EndObject();
+                            writer.EndEvent();
+                        break;case JobTraceEvent::Type::BarrierWait:
+                            writer.Complete("Barrier Wait", "barrier", buffer.tid, event.begin, event.end);
+                    }
+                });
+            });
+        }
+
+        static void WriteChromeTrace(std::ostream& out)
+        {
+            JsonWriter json{out};
+            WriteChromeTrace(json);
+        }
+    };
+}
@@ -1,6 +1,7 @@
 #include <yyjson.h>
 
 #include "Core.hpp"
+#include "Arena.hpp"
 
 #include <optional>
 #include <string>
@@ -52,9 +53,10 @@ JsonValue JsonIterator::operator*() const noexcept
 // ---------------------------------------------------------------------------------------------------------------------
 
 const char* JsonValue::string() const noexcept { return yyjson_get_str(val); }
-std::optional<uint64_t> JsonValue::uint64() const noexcept { if (yyjson_is_int(val)) return yyjson_get_int(val); return std::nullopt; }
+std::optional<uint64_t> JsonValue::uint64() const noexcept { if (yyjson_is_uint(val)) return yyjson_get_uint(val); return std::nullopt; }
 std::optional<int64_t> JsonValue::int64() const noexcept { if (yyjson_is_sint(val)) return yyjson_get_sint(val); return std::nullopt; }
 std::optional<double> JsonValue::real() const noexcept { if (yyjson_is_real(val)) return yyjson_get_real(val); return std::nullopt; }
+std::optional<bool> JsonValue::boolean() const noexcept { if (yyjson_is_bool(val)) return yyjson_get_bool(val); return std::nullopt; }
 bool JsonValue::obj() const noexcept { return yyjson_is_obj(val); }
 bool JsonValue::arr() const noexcept { return yyjson_is_arr(val); }
 JsonValue::operator bool() const noexcept { return val; }
@@ -67,12 +69,60 @@ JsonValue JsonValue::operator[](int64_t index) const noexcept { return JsonValue
 //         JsonDocument
 // ---------------------------------------------------------------------------------------------------------------------
 
-JsonDocument::JsonDocument(std::string_view json)
-    : doc(yyjson_read(json.data(), json.size(), YYJSON_READ_ALLOW_COMMENTS | YYJSON_READ_ALLOW_TRAILING_COMMAS))
+// yyjson allocator over a nova::Arena. Reallocating the most recent block extends it in place and free is a no-op.
+// Exceptions must not unwind through yyjson, so running out of arena space is reported as an allocation failure
+
+static
+void* JsonArenaMalloc(void* ctx, size_t size)
+{
+    try {
+        return static_cast<nova::Arena*>(ctx)->Allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+static
+void* JsonArenaRealloc(void* ctx, void* ptr, size_t old_size, size_t size)
 {
-    if (!doc) NOVA_THROW("Error parsing json");
+    auto* arena = static_cast<nova::Arena*>(ctx);
+    try {
+        arena->Free(ptr, old_size);
+        void* block = arena->Allocate(size);
+        if (block != ptr) {
+            std::memcpy(block, ptr, std::min(old_size, size));
+        }
+        return block;
+    } catch (...) {
+        return nullptr;
+    }
 }
 
+static
+void JsonArenaFree(void*, void*)
+{
+}
+
+static
+yyjson_doc* ReadDocument(char* data, size_t size, yyjson_read_flag flags, nova::Arena* arena)
+{
+    flags |= YYJSON_READ_ALLOW_COMMENTS | YYJSON_READ_ALLOW_TRAILING_COMMAS;
+
+    yyjson_alc alc{ JsonArenaMalloc, JsonArenaRealloc, JsonArenaFree, arena };
+    yyjson_read_err err;
+    auto* doc = yyjson_read_opts(data, size, flags, arena ? &alc : nullptr, &err);
+    if (!doc) NOVA_THROW("Error parsing json: {} at offset {}", err.msg, err.pos);
+    return doc;
+}
+
+JsonDocument::JsonDocument(std::string_view json, nova::Arena* arena)
+    : doc(ReadDocument(const_cast<char*>(json.data()), json.size(), 0, arena))
+{}
+
+JsonDocument::JsonDocument(char* buffer, size_t size, nova::Arena* arena)
+    : doc(ReadDocument(buffer, size, YYJSON_READ_INSITU, arena))
+{}
+
 JsonDocument::~JsonDocument()
 {
     yyjson_doc_free(doc);
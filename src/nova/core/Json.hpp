@@ -6,6 +6,8 @@
 struct yyjson_val;
 struct yyjson_doc;
 
+namespace nova { class Arena; }
+
 struct JsonValue;
 
 struct JsonIterator
@@ -64,6 +66,7 @@ struct JsonValue
     std::optional<uint64_t> uint64() const noexcept;
     std::optional<int64_t> int64() const noexcept;
     std::optional<double> real() const noexcept;
+    std::optional<bool> boolean() const noexcept;
     bool obj() const noexcept;
     bool arr() const noexcept;
     operator bool() const noexcept;
@@ -84,12 +87,27 @@ namespace std {
     template<size_t Idx> auto get(JsonValue ptr) { if constexpr (Idx == 0) { return ptr.key; } else { return ptr; } }
 }
 
+// Parsed DOM. When constructed with an arena all nodes (and the copies of string values) are bump allocated from it
+// instead of malloc, destroying the document frees nothing and memory is reclaimed by rewinding the arena. The arena
+// must not be rewound past the document while it is alive.
+
 struct JsonDocument
 {
+    // Zero bytes required past the end of a buffer parsed in place
+    static constexpr size_t InSituPadding = 4;
+
     yyjson_doc* doc = nullptr;
 
-    JsonDocument(std::string_view json);
+    JsonDocument(std::string_view json, nova::Arena* arena = nullptr);
+
+    // Parses a mutable buffer in place, unescaping string values into it and referencing them from the document
+    // instead of copying them. buffer[size, size + InSituPadding) must be zero and the buffer must outlive the document
+    JsonDocument(char* buffer, size_t size, nova::Arena* arena = nullptr);
+
     ~JsonDocument();
 
+    JsonDocument(const JsonDocument&) = delete;
+    auto operator=(const JsonDocument&) = delete;
+
     JsonValue root() const noexcept;
 };
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Json.hpp"
+#include "JsonWriter.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                               JSON Binding
+// -----------------------------------------------------------------------------
+
+    // Declarative mapping between a struct and a JSON object. Bind a type at global scope with
+    //
+    //     NOVA_JSON_BIND(Foo,
+    //         NOVA_JSON_FIELD("name",  name),
+    //         NOVA_JSON_FIELD("paths", paths));
+    //
+    // and read it with JsonRead(value, foo) or write it with JsonWrite(writer, foo).
+    //
+    // Reading walks the members of each object exactly once. Every key is hashed as it is visited and dispatched
+    // against the compile-time hashes of the bound fields, so the cost no longer scales with (fields x members)
+    // as with one operator[] lookup per field. Unknown keys are ignored, values of the wrong type throw.
+    //
+    // Supported member types are bool, integers, floats, std::string, fs::path, std::optional (left empty when the
+    // key is absent, omitted when written), std::vector (a lone value is read as a single element), std::variant
+    // (the first alternative whose JSON kind matches is chosen) and other bound types.
+
+    template<typename T>
+    struct JsonBinding;
+
+    template<typename T>
+    concept JsonBound = requires { JsonBinding<T>::Fields; };
+
+    namespace detail
+    {
+        inline constexpr u64 JsonKeyHashSeed  = 0xcbf29ce484222325ull;
+        inline constexpr u64 JsonKeyHashPrime = 0x00000100000001b3ull;
+
+        constexpr
+        u64 JsonKeyHash(std::string_view key) noexcept
+        {
+            u64 hash = JsonKeyHashSeed;
+            for (char c : key) {
+                hash = (hash ^ u8(c)) * JsonKeyHashPrime;
+            }
+            return hash;
+        }
+
+        template<typename T> inline constexpr bool IsJsonOptional = false;
+        template<typename T> inline constexpr bool IsJsonOptional<std::optional<T>> = true;
+
+        template<typename T> inline constexpr bool IsJsonVector = false;
+        template<typename T> inline constexpr bool IsJsonVector<std::vector<T>> = true;
+
+        template<typename T> inline constexpr bool IsJsonVariant = false;
+        template<typename... Ts> inline constexpr bool IsJsonVariant<std::variant<Ts...>> = true;
+    }
+
+    template<typename C, typename M>
+    struct JsonField
+    {
+        std::string_view key;
+        u64             hash;
+        M C::*        member;
+
+        consteval JsonField(std::string_view _key, M C::* _member)
+            : key(_key)
+            , hash(detail::JsonKeyHash(_key))
+            , member(_member)
+        {}
+    };
+
+#define NOVA_JSON_FIELD(key, member) ::nova::JsonField(key, &Self::member)
+
+#define NOVA_JSON_BIND(type, ...)                                    \
+    template<>                                                       \
+    struct nova::JsonBinding<type>                                   \
+    {                                                                \
+        using Self = type;                                           \
+        static constexpr auto Fields = std::tuple{ __VA_ARGS__ };    \
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Reading
+// -----------------------------------------------------------------------------
+
+    template<typename T>
+    void JsonRead(JsonValue value, T& out);
+
+    namespace detail
+    {
+        [[noreturn]] NOVA_NO_INLINE
+        inline void JsonTypeError(JsonValue value, std::string_view expected)
+        {
+            NOVA_THROW("JSON value [{}] is not {}", value.key ? value.key : "<element>", expected);
+        }
+
+        // Whether a value could be read as T, used to select variant alternatives
+        template<typename T>
+        bool JsonKindMatches(JsonValue value) noexcept
+        {
+            if constexpr (IsJsonOptional<T>) {
+                return JsonKindMatches<typename T::value_type>(value);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                return value.boolean().has_value();
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return value.uint64() || value.int64() || value.real();
+            } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, fs::path>) {
+                return value.string();
+            } else if constexpr (IsJsonVector<T>) {
+                return value.arr();
+            } else {
+                return value.obj();
+            }
+        }
+
+        template<typename Variant, usz I = 0>
+        void JsonReadVariant(JsonValue value, Variant& out)
+        {
+            if constexpr (I == std::variant_size_v<Variant>) {
+                JsonTypeError(value, "any alternative of the expected variant");
+            } else {
+                using Alt = std::variant_alternative_t<I, Variant>;
+                if (JsonKindMatches<Alt>(value)) {
+                    JsonRead(value, out.template emplace<I>());
+                } else {
+                    JsonReadVariant<Variant, I + 1>(value, out);
+                }
+            }
+        }
+
+        template<typename T>
+        void JsonReadObject(JsonValue value, T& out)
+        {
+            if (!value.obj()) {
+                JsonTypeError(value, "an object");
+            }
+
+            for (auto member : value.iter()) {
+                const char* key = member.key;
+                u64 hash = JsonKeyHashSeed;
+                usz length = 0;
+                for (; key[length]; ++length) {
+                    hash = (hash ^ u8(key[length])) * JsonKeyHashPrime;
+                }
+
+                std::apply([&](const auto&... fields) {
+                    (void)((fields.hash == hash && fields.key == std::string_view(key, length)
+                        && (JsonRead(member, out.*fields.member), true)) || ...);
+                }, JsonBinding<T>::Fields);
+            }
+        }
+    }
+
+    template<typename T>
+    void JsonRead(JsonValue value, T& out)
+    {
+        if constexpr (detail::IsJsonOptional<T>) {
+            if (value) {
+                JsonRead(value, out.emplace());
+            }
+        } else if constexpr (std::is_same_v<T, bool>) {
+            auto b = value.boolean();
+            if (!b) detail::JsonTypeError(value, "a boolean");
+            out = *b;
+        } else if constexpr (std::is_integral_v<T>) {
+            auto Narrow = [&](auto v) {
+                if (!std::in_range<T>(v)) {
+                    detail::JsonTypeError(value, Fmt("an integer in [{}, {}]", std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+                }
+                out = T(v);
+            };
+
+            if      (auto u = value.uint64()) Narrow(*u);
+            else if (auto i = value.int64())  Narrow(*i);
+            else detail::JsonTypeError(value, "an integer");
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if      (auto r = value.real())   out = T(*r);
+            else if (auto u = value.uint64()) out = T(*u);
+            else if (auto i = value.int64())  out = T(*i);
+            else detail::JsonTypeError(value, "a number");
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, fs::path>) {
+            auto str = value.string();
+            if (!str) detail::JsonTypeError(value, "a string");
+            out = str;
+        } else if constexpr (detail::IsJsonVector<T>) {
+            out.clear();
+            for (auto element : value) {
+                JsonRead(element, out.emplace_back());
+            }
+        } else if constexpr (detail::IsJsonVariant<T>) {
+            detail::JsonReadVariant(value, out);
+        } else {
+            static_assert(JsonBound<T>, "Type has no JSON binding, declare one with NOVA_JSON_BIND");
+            detail::JsonReadObject(value, out);
+        }
+    }
+
+    template<typename T>
+    T JsonRead(JsonValue value)
+    {
+        T out{};
+        JsonRead(value, out);
+        return out;
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Writing
+// -----------------------------------------------------------------------------
+
+    template<typename T>
+    void JsonWrite(JsonWriter& writer, const T& value)
+    {
+        if constexpr (detail::IsJsonOptional<T>) {
+            if (value) JsonWrite(writer, *value);
+            else       writer = nullptr;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            writer = value;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            writer.Value(value);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            writer = StringView(value);
+        } else if constexpr (std::is_same_v<T, fs::path>) {
+            writer = StringView(value.string());
+        } else if constexpr (detail::IsJsonVector<T>) {
+            writer.Array();
+            for (const auto& element : value) {
+                JsonWrite(writer, element);
+            }
+            writer.EndArray();
+        } else if constexpr (detail::IsJsonVariant<T>) {
+            std::visit([&](const auto& alt) { JsonWrite(writer, alt); }, value);
+        } else {
+            static_assert(JsonBound<T>, "Type has no JSON binding, declare one with NOVA_JSON_BIND");
+            writer.Object();
+            std::apply([&](const auto&... fields) {
+                ([&](const auto& field) {
+                    const auto& member = value.*field.member;
+                    if constexpr (detail::IsJsonOptional<std::remove_cvref_t<decltype(member)>>) {
+                        if (!member) return;
+                    }
+                    writer.Key(field.key);
+                    JsonWrite(writer, member);
+                }(fields), ...);
+            }, JsonBinding<T>::Fields);
+            writer.EndObject();
+        }
+    }
+}
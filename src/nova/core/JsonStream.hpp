@@ -0,0 +1,379 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Arena.hpp"
+#include "Files.hpp"
+#include "Json.hpp"
+#include "Parallel.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                            JSON Stream Reader
+// -----------------------------------------------------------------------------
+
+    // Splits a stream of JSON text into independent records and parses them one at a time, so inputs far larger
+    // than memory can be processed with a DOM per record instead of a DOM for the whole input.
+    //
+    //   Records        - every top level value is a record, e.g. newline delimited JSON (NDJSON / JSON Lines)
+    //   ArrayElements  - records are the elements of the first array in the input, e.g. the "traceEvents" of a
+    //                    Chrome trace or a top level array. Anything outside of that array is skipped
+    //
+    // The source is either a block of memory (a string or a MappedFile, records are views straight into it) or a
+    // File that is read in chunks into an internal buffer, which only grows if a single record exceeds the chunk
+    // size. Records are split by a lightweight scan that tracks nesting, strings and comments (which the per-record
+    // parse accepts), validation is left to the per-record parse.
+
+    enum class JsonStreamMode
+    {
+        Records,
+        ArrayElements,
+    };
+
+    class JsonStreamReader
+    {
+    public:
+        static constexpr usz DefaultChunkSize = 4ull * 1024 * 1024;
+
+    private:
+        enum class ScanResult
+        {
+            Record,
+            NeedData,
+            End,
+        };
+
+        JsonStreamMode mode;
+
+        File*                 file = nullptr;
+        std::vector<char>   buffer;
+        bool           file_eof = false;
+
+        const char*     data = nullptr;
+        usz             size = 0;
+        usz           cursor = 0;
+        usz       chunk_size = DefaultChunkSize;
+
+        // Scan state for the prelude of ArrayElements mode, carried across refills
+        bool   prelude_in_string = false;
+        bool      prelude_escape = false;
+        char     prelude_comment = 0; // '/' inside a line comment, '*' inside a block comment
+        bool         in_elements = false;
+        bool            finished = false;
+
+        u64 record_count = 0;
+
+        Arena arena{ 1ull * 1024 * 1024 * 1024 };
+
+    public:
+        JsonStreamReader(StringView text, JsonStreamMode _mode = JsonStreamMode::Records, usz _chunk_size = DefaultChunkSize)
+            : mode(_mode)
+            , data(text.Data())
+            , size(text.Size())
+            , chunk_size(_chunk_size)
+        {}
+
+        JsonStreamReader(const MappedFile& mapped, JsonStreamMode _mode = JsonStreamMode::Records, usz _chunk_size = DefaultChunkSize)
+            : mode(_mode)
+            , data(static_cast<const char*>(mapped.GetAddress()))
+            , size(mapped.GetSize())
+            , chunk_size(_chunk_size)
+        {}
+
+        JsonStreamReader(File& _file, JsonStreamMode _mode = JsonStreamMode::Records, usz _chunk_size = DefaultChunkSize)
+            : mode(_mode)
+            , file(&_file)
+            , chunk_size(std::max(_chunk_size, usz(4096)))
+        {
+            buffer.resize(chunk_size);
+            data = buffer.data();
+        }
+
+        JsonStreamReader(const JsonStreamReader&) = delete;
+        auto operator=(const JsonStreamReader&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        // Returns the text of the next record, valid until the next call. Returns false at the end of the input
+        bool NextRecord(std::string_view& record)
+        {
+            for (;;) {
+                switch (ScanRecord(record)) {
+                    break;case ScanResult::Record:   return true;
+                    break;case ScanResult::End:      return false;
+                    break;case ScanResult::NeedData: Refill();
+                }
+            }
+        }
+
+        // Parses and visits every remaining record in order as fn(JsonValue). Each document lives in an arena that
+        // is rewound after the callback returns, so values must be copied out of it
+        template<typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            std::string_view record;
+            while (NextRecord(record)) {
+                NOVA_ARENA_SCOPE(arena);
+                JsonDocument doc(record, &arena);
+                fn(doc.root());
+            }
+        }
+
+        // Parses records in parallel batches of up to the chunk size, invoking fn(JsonValue) concurrently and in no
+        // particular order within a batch. Batches are processed in input order. The caller participates, and the
+        // first exception thrown by a parse or callback is rethrown after the current batch
+        template<typename Fn>
+        void ParallelForEach(JobSystem& system, Fn&& fn, u64 grain = 64)
+        {
+            std::vector<std::string_view> batch;
+            usz batch_bytes = 0;
+
+            auto Flush = [&] {
+                ParallelFor(system, batch.size(), grain, [&](u64 i) {
+                    JsonDocument doc(batch[i]);
+                    fn(doc.root());
+                });
+                batch.clear();
+                batch_bytes = 0;
+            };
+
+            for (;;) {
+                std::string_view record;
+                auto result = ScanRecord(record);
+                if (result == ScanResult::Record) {
+                    batch.emplace_back(record);
+                    batch_bytes += record.size();
+                    if (batch_bytes >= chunk_size) {
+                        Flush();
+                    }
+                    continue;
+                }
+
+                // Records in the batch are views into the buffer, so they must be consumed before it is refilled
+                Flush();
+                if (result == ScanResult::End) {
+                    break;
+                }
+                Refill();
+            }
+        }
+
+        template<typename Fn>
+        void ParallelForEach(Fn&& fn, u64 grain = 64)
+        {
+            ParallelForEach(JobSystem::GetDefault(), std::forward<Fn>(fn), grain);
+        }
+
+        u64 GetRecordCount() const noexcept
+        {
+            return record_count;
+        }
+
+    private:
+        static bool IsSpace(char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        bool AtEndOfInput() const noexcept
+        {
+            return !file || file_eof;
+        }
+
+        static constexpr usz NeedMore = ~usz(0);
+
+        // Returns the offset one past the // or /* */ comment starting at data[start], start if there is no comment
+        // there, or NeedMore if the input ends before that can be told
+        usz SkipComment(usz start) const noexcept
+        {
+            if (start + 1 >= size) {
+                return AtEndOfInput() ? start : NeedMore;
+            }
+
+            char kind = data[start + 1];
+            if (kind == '/') {
+                for (usz pos = start + 2; pos < size; ++pos) {
+                    if (data[pos] == '\n') return pos + 1;
+                }
+                return AtEndOfInput() ? size : NeedMore;
+            }
+
+            if (kind == '*') {
+                for (usz pos = start + 3; pos < size; ++pos) {
+                    if (data[pos] == '/' && data[pos - 1] == '*') return pos + 1;
+                }
+                // Unterminated comments are left for the record parse to report
+                return AtEndOfInput() ? start : NeedMore;
+            }
+
+            return start;
+        }
+
+        // Moves the unconsumed tail to the front of the buffer and reads more, growing the buffer if the tail
+        // already fills it
+        void Refill()
+        {
+            NOVA_ASSERT(file && !file_eof, "JsonStreamReader refilled past the end of the input");
+
+            usz tail = size - cursor;
+            std::memmove(buffer.data(), buffer.data() + cursor, tail);
+            if (tail == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+
+            usz read = std::fread(buffer.data() + tail, 1, buffer.size() - tail, file->file);
+            if (read < buffer.size() - tail) {
+                file_eof = true;
+            }
+
+            data = buffer.data();
+            size = tail + read;
+            cursor = 0;
+        }
+
+        // Skips input up to and including the opening bracket of the first array. Input before the cursor is
+        // consumed, a comment delimiter split by the end of the buffer is left at the cursor for the next refill
+        bool ScanPrelude()
+        {
+            for (; cursor < size; ++cursor) {
+                char c = data[cursor];
+                bool split = cursor + 1 == size && !AtEndOfInput();
+                if (prelude_in_string) {
+                    if (prelude_escape)  prelude_escape = false;
+                    else if (c == '\\') prelude_escape = true;
+                    else if (c == '"')  prelude_in_string = false;
+                } else if (prelude_comment == '/') {
+                    if (c == '\n') prelude_comment = 0;
+                } else if (prelude_comment == '*') {
+                    if (c == '*') {
+                        if (split) return false;
+                        if (cursor + 1 < size && data[cursor + 1] == '/') {
+                            prelude_comment = 0;
+                            cursor++;
+                        }
+                    }
+                } else if (c == '"') {
+                    prelude_in_string = true;
+                } else if (c == '/') {
+                    if (split) return false;
+                    char next = cursor + 1 < size ? data[cursor + 1] : 0;
+                    if (next == '/' || next == '*') {
+                        prelude_comment = next;
+                        cursor++;
+                    }
+                } else if (c == '[') {
+                    cursor++;
+                    in_elements = true;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Finds the end of the value starting at data[start], returns the offset one past it or 0 if the value is
+        // incomplete
+        usz FindValueEnd(usz start) const noexcept
+        {
+            usz pos = start;
+            char first = data[pos];
+
+            if (first == '{' || first == '[' || first == '"') {
+                u32 depth = 0;
+                bool in_string = false;
+                for (; pos < size; ++pos) {
+                    char c = data[pos];
+                    if (in_string) {
+                        if (c == '\\') pos++;
+                        else if (c == '"') {
+                            in_string = false;
+                            if (depth == 0) return pos + 1;
+                        }
+                    } else if (c == '"') {
+                        in_string = true;
+                    } else if (c == '/') {
+                        usz end = SkipComment(pos);
+                        if (end == NeedMore) return 0;
+                        if (end != pos) pos = end - 1;
+                    } else if (c == '{' || c == '[') {
+                        depth++;
+                    } else if (c == '}' || c == ']') {
+                        if (--depth == 0) return pos + 1;
+                    }
+                }
+                return 0;
+            }
+
+            // Scalar, runs until the next delimiter
+            for (++pos; pos < size; ++pos) {
+                char c = data[pos];
+                if (IsSpace(c) || c == ',' || c == ']' || c == '}' || c == '/') {
+                    return pos;
+                }
+            }
+            return AtEndOfInput() ? pos : 0;
+        }
+
+        ScanResult ScanRecord(std::string_view& record)
+        {
+            if (finished) {
+                return ScanResult::End;
+            }
+
+            if (mode == JsonStreamMode::ArrayElements && !in_elements) {
+                if (!ScanPrelude()) {
+                    if (AtEndOfInput()) {
+                        finished = true;
+                        return ScanResult::End;
+                    }
+                    return ScanResult::NeedData;
+                }
+            }
+
+            for (;;) {
+                while (cursor < size && (IsSpace(data[cursor]) || (in_elements && data[cursor] == ','))) {
+                    cursor++;
+                }
+
+                if (cursor == size || data[cursor] != '/') {
+                    break;
+                }
+
+                usz end = SkipComment(cursor);
+                if (end == NeedMore) {
+                    return ScanResult::NeedData;
+                }
+                if (end == cursor) {
+                    break;
+                }
+                cursor = end;
+            }
+
+            if (cursor == size) {
+                if (AtEndOfInput()) {
+                    NOVA_ASSERT(!in_elements, "JSON stream ended inside of the record array");
+                    finished = true;
+                    return ScanResult::End;
+                }
+                return ScanResult::NeedData;
+            }
+
+            if (in_elements && data[cursor] == ']') {
+                finished = true;
+                return ScanResult::End;
+            }
+
+            usz end = FindValueEnd(cursor);
+            if (!end) {
+                if (AtEndOfInput()) {
+                    NOVA_THROW("JSON stream truncated in record {} at offset {}", record_count, cursor);
+                }
+                return ScanResult::NeedData;
+            }
+
+            record = { data + cursor, end - cursor };
+            cursor = end;
+            record_count++;
+            return ScanResult::Record;
+        }
+    };
+}
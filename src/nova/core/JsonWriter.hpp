@@ -2,21 +2,140 @@
 
 #include "Core.hpp"
 
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#  include <emmintrin.h>
+#  define NOVA_JSON_SSE2 1
+#endif
+
 namespace nova
 {
+    namespace detail
+    {
+        // Returns the first character in [str, end) that must be escaped in a JSON string: '"', '\' or a control
+        // character. Sixteen bytes are tested at a time where SSE2 is available, eight with SWAR otherwise
+        inline
+        const char* FindJsonEscape(const char* str, const char* end) noexcept
+        {
+#ifdef NOVA_JSON_SSE2
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i slash = _mm_set1_epi8('\\');
+            const __m128i limit = _mm_set1_epi8(0x1F);
+            for (; end - str >= 16; str += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+                __m128i hits = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash)),
+                    _mm_cmpeq_epi8(_mm_max_epu8(v, limit), limit));
+                if (u32 mask = u32(_mm_movemask_epi8(hits))) {
+                    return str + std::countr_zero(mask);
+                }
+            }
+#else
+            constexpr u64 Ones  = 0x0101010101010101ull;
+            constexpr u64 Highs = 0x8080808080808080ull;
+            for (; end - str >= 8; str += 8) {
+                u64 v;
+                std::memcpy(&v, str, 8);
+                u64 quote = v ^ (Ones * '"');
+                u64 slash = v ^ (Ones * '\\');
+                u64 hits = ((quote - Ones) & ~quote) | ((slash - Ones) & ~slash) | ((v - Ones * 0x20) & ~v);
+                if (hits & Highs) {
+                    break;
+                }
+            }
+#endif
+            for (; str < end; ++str) {
+                u8 c = u8(*str);
+                if (c < 0x20 || c == '"' || c == '\\') {
+                    return str;
+                }
+            }
+            return end;
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                                JSON Writer
+// -----------------------------------------------------------------------------
+
+    // Streaming JSON writer. Tokens are formatted with fmt (shortest round-trip floats, no locale) into an internal
+    // memory buffer, which is either kept for the caller (View/Take) or flushed to an ostream or appended to a
+    // string in large blocks and on destruction. Compact mode omits all whitespace.
+
     struct JsonWriter
     {
-        std::ostream&          out;
+        static constexpr usz FlushThreshold = 64 * 1024;
+
+        std::ostream*   out = nullptr;
+        std::string* target = nullptr;
+
+        fmt::memory_buffer buffer;
+
         std::string  indent_string = "  ";
         u32                  depth = 0;
         bool         first_element = true;
         bool               has_key = false;
+        bool               compact = false;
 
     public:
+        // Writes into the internal buffer only
+        explicit JsonWriter(bool _compact = false)
+            : compact(_compact)
+        {}
+
+        JsonWriter(std::ostream& _out, bool _compact = false)
+            : out(&_out)
+            , compact(_compact)
+        {}
+
+        // Appends to a string, which may already hold data
+        JsonWriter(std::string& _target, bool _compact = false)
+            : target(&_target)
+            , compact(_compact)
+        {}
+
+        ~JsonWriter()
+        {
+            Flush();
+        }
+
+        JsonWriter(const JsonWriter&) = delete;
+        auto operator=(const JsonWriter&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        void Flush()
+        {
+            if (buffer.size() == 0 || (!out && !target)) {
+                return;
+            }
+
+            if (out) {
+                out->write(buffer.data(), std::streamsize(buffer.size()));
+            } else {
+                target->append(buffer.data(), buffer.size());
+            }
+            buffer.clear();
+        }
+
+        // Contents written since the last flush, the whole document when there is no output attached
+        std::string_view View() const noexcept
+        {
+            return { buffer.data(), buffer.size() };
+        }
+
+        std::string Take()
+        {
+            std::string str = fmt::to_string(buffer);
+            buffer.clear();
+            return str;
+        }
+
+// -----------------------------------------------------------------------------
+
         void Indent()
         {
             for (u32 i = 0; i < depth; ++i) {
-                out << indent_string;
+                Append(indent_string);
             }
         }
 
@@ -27,12 +146,16 @@ namespace nova
                 return;
             }
 
+            if (buffer.size() >= FlushThreshold) [[unlikely]] {
+                Flush();
+            }
+
             if (!first_element) {
-                out << ',';
+                buffer.push_back(',');
             }
 
-            if (depth > 0) {
-                out << '\n';
+            if (depth > 0 && !compact) {
+                buffer.push_back('\n');
                 Indent();
             }
 
@@ -42,7 +165,12 @@ namespace nova
         JsonWriter& Key(StringView key)
         {
             NewElement();
-            out << '"' << key << "\": ";
+            AppendQuoted(key);
+            if (compact) {
+                buffer.push_back(':');
+            } else {
+                Append(": ");
+            }
             has_key = true;
             return *this;
         }
@@ -55,7 +183,7 @@ namespace nova
         void Object()
         {
             NewElement();
-            out << '{';
+            buffer.push_back('{');
             ++depth;
             first_element = true;
         }
@@ -63,18 +191,18 @@ namespace nova
         void EndObject()
         {
             --depth;
-            if (!first_element) {
-                out << '\n';
+            if (!first_element && !compact) {
+                buffer.push_back('\n');
                 Indent();
             }
-            out << '}';
+            buffer.push_back('}');
             first_element = false;
         }
 
         void Array()
         {
             NewElement();
-            out << '[';
+            buffer.push_back('[');
             ++depth;
             first_element = true;
         }
@@ -82,48 +210,98 @@ namespace nova
         void EndArray()
         {
             --depth;
-            if (!first_element) {
-                out << '\n';
+            if (!first_element && !compact) {
+                buffer.push_back('\n');
                 Indent();
             }
 
-            out << ']';
+            buffer.push_back(']');
             first_element = false;
         }
 
         void String(StringView str)
         {
             NewElement();
-            out << '"' << str << '"';
+            AppendQuoted(str);
+        }
+
+        // Writes pre-formatted JSON verbatim
+        void Raw(StringView json)
+        {
+            NewElement();
+            Append(json);
         }
 
-        void operator=(StringView str) { String(str); }
-        void operator=(char str)       { String({ &str, 1ull }); }
+        void operator=(StringView str)  { String(str); }
+        void operator=(const char* str) { String(str); } // Otherwise string literals would convert to bool
+        void operator=(char str)        { String({ &str, 1ull }); }
 
+        // Non-finite floats are written as null, since JSON has no representation for NaN or infinity
         template<typename T>
         void Value(T&& value)
         {
             NewElement();
-            out << std::forward<T>(value);
-        }
-
-        void operator=(f64  value) { Value(value);                }
-        void operator=(f32  value) { Value(value);                }
-        void operator=(i64  value) { Value(value);                }
-        void operator=(i32  value) { Value(value);                }
-        void operator=(i16  value) { Value(value);                }
-        void operator=(i8   value) { Value(value);                }
-        void operator=(u64  value) { Value(value);                }
-        void operator=(u32  value) { Value(value);                }
-        void operator=(u16  value) { Value(value);                }
-        void operator=(u8   value) { Value(value);                }
-        void operator=(bool value) { Value(value ? "true" : "false"); }
-        void operator=(std::nullptr_t) { Value("null");               }
+            if constexpr (std::is_floating_point_v<std::remove_cvref_t<T>>) {
+                if (!std::isfinite(value)) {
+                    Append("null");
+                    return;
+                }
+            }
+            fmt::format_to(std::back_inserter(buffer), "{}", std::forward<T>(value));
+        }
+
+        void operator=(f64  value) { Value(value);                  }
+        void operator=(f32  value) { Value(value);                  }
+        void operator=(i64  value) { Value(value);                  }
+        void operator=(i32  value) { Value(value);                  }
+        void operator=(i16  value) { Value(value);                  }
+        void operator=(i8   value) { Value(value);                  }
+        void operator=(u64  value) { Value(value);                  }
+        void operator=(u32  value) { Value(value);                  }
+        void operator=(u16  value) { Value(value);                  }
+        void operator=(u8   value) { Value(value);                  }
+        void operator=(bool value) { Raw(value ? "true" : "false"); }
+        void operator=(std::nullptr_t) { Raw("null");               }
 
         template<typename T>
         void operator<<(T&& t)
         {
             this->operator=(std::forward<T>(t));
         }
+
+    private:
+        void Append(StringView str)
+        {
+            buffer.append(str.begin(), str.end());
+        }
+
+        void AppendQuoted(StringView str)
+        {
+            buffer.push_back('"');
+
+            const char* cur = str.begin();
+            const char* end = str.end();
+            for (;;) {
+                const char* next = detail::FindJsonEscape(cur, end);
+                buffer.append(cur, next);
+                if (next == end) {
+                    break;
+                }
+
+                switch (*next) {
+                    break;case '"':  Append("\\\"");
+                    break;case '\\': Append("\\\\");
+                    break;case '\n': Append("\\n");
+                    break;case '\r': Append("\\r");
+                    break;case '\t': Append("\\t");
+                    break;case '\b': Append("\\b");
+                    break;case '\f': Append("\\f");
+                    break;default:   fmt::format_to(std::back_inserter(buffer), "\\u{:04x}", u32(u8(*next)));
+                }
+                cur = next + 1;
+            }
+
+            buffer.push_back('"');
+        }
     };
 }
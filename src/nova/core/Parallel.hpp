@@ -0,0 +1,256 @@
+#pragma once
+
+#include "JobSystem.hpp"
+
+namespace nova
+{
+    namespace detail
+    {
+        // Shared state for a single parallel loop.
+        //
+        // Participants (the calling thread plus up to one helper job per worker) claim chunks from a shared cursor.
+        // Chunk sizes are guided by the remaining work, so early claims are large and the tail is split finely for
+        // load balancing. The loop body is only invoked for successfully claimed chunks, and the caller does not
+        // return until every claimed chunk completes, so the body may safely live on the caller's stack even when
+        // helper jobs start late.
+
+        struct ParallelLoop : RefCounted
+        {
+            std::atomic<u64>      next = 0;
+            std::atomic<u64> completed = 0;
+
+            u64        count = 0;
+            u64        grain = 1;
+            u32 participants = 1;
+
+            void*                                                 body = nullptr;
+            void(*run)(void* body, u64 first, u64 last, u32 slot) = nullptr;
+
+            std::atomic_flag      failed;
+            std::exception_ptr exception;
+
+            bool Claim(u64& first, u64& last)
+            {
+                u64 cur = next.load(std::memory_order_relaxed);
+                for (;;) {
+                    if (cur >= count) {
+                        return false;
+                    }
+
+                    u64 remaining = count - cur;
+                    u64 chunk = std::min(remaining, std::max(grain, remaining / (u64(participants) * 2)));
+                    if (next.compare_exchange_weak(cur, cur + chunk, std::memory_order_relaxed)) {
+                        first = cur;
+                        last = cur + chunk;
+                        return true;
+                    }
+                }
+            }
+
+            void Complete(u64 items)
+            {
+                if (completed.fetch_add(items, std::memory_order_acq_rel) + items == count) {
+                    completed.notify_all();
+                }
+            }
+
+            void Participate(u32 slot)
+            {
+                u64 first, last;
+                while (Claim(first, last)) {
+                    NOVA_CLEANUP_ON_EXCEPTION(&) { Complete(last - first); };
+                    run(body, first, last, slot);
+                    Complete(last - first);
+                }
+            }
+
+            void Wait()
+            {
+                u64 c = completed.load(std::memory_order_acquire);
+                while (c != count) {
+                    completed.wait(c);
+                    c = completed.load(std::memory_order_acquire);
+                }
+            }
+
+            // Stop handing out new chunks and account for them as completed.
+            // The first exception thrown by any participant is rethrown on the calling thread.
+            void Abandon(std::exception_ptr error)
+            {
+                if (!failed.test_and_set()) {
+                    exception = std::move(error);
+                }
+
+                u64 claimed = next.exchange(count);
+                if (claimed < count) {
+                    Complete(count - claimed);
+                }
+            }
+        };
+
+        template<typename Run>
+        void RunParallelLoop(JobSystem& system, u64 count, u64 grain, Run& run)
+        {
+            u64 chunks = (count + grain - 1) / grain;
+            u32 helpers = u32(std::min(u64(system.GetWorkerCount()), chunks - 1));
+
+            Ref loop = new ParallelLoop();
+            loop->count = count;
+            loop->grain = grain;
+            loop->participants = helpers + 1;
+            loop->body = &run;
+            loop->run = [](void* body, u64 first, u64 last, u32 slot) {
+                (*static_cast<Run*>(body))(first, last, slot);
+            };
+
+            for (u32 i = 0; i < helpers; ++i) {
+                Job::Create(&system, [loop, slot = i + 1] {
+                    try {
+                        loop->Participate(slot);
+                    } catch (...) {
+                        loop->Abandon(std::current_exception());
+                    }
+                })->Submit();
+            }
+
+            try {
+                loop->Participate(0);
+            } catch (...) {
+                loop->Abandon(std::current_exception());
+            }
+
+            loop->Wait();
+
+            if (loop->exception) {
+                std::rethrow_exception(loop->exception);
+            }
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                              Parallel For
+// -----------------------------------------------------------------------------
+
+    // Invokes fn(index) for every index in [0, count), splitting the range across the job system.
+    // The calling thread participates, so this may be safely called from within a job.
+    // If any invocation throws, remaining indices are skipped and the first exception is rethrown to the caller.
+    template<typename Fn>
+    void ParallelFor(JobSystem& system, u64 count, u64 grain, Fn&& fn)
+    {
+        grain = std::max(grain, u64(1));
+        if (count <= grain || system.GetWorkerCount() == 0) {
+            for (u64 i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        auto run = [&](u64 first, u64 last, u32) {
+            for (u64 i = first; i < last; ++i) {
+                fn(i);
+            }
+        };
+
+        detail::RunParallelLoop(system, count, grain, run);
+    }
+
+    template<typename Fn>
+    void ParallelFor(u64 count, u64 grain, Fn&& fn)
+    {
+        ParallelFor(JobSystem::GetDefault(), count, grain, std::forward<Fn>(fn));
+    }
+
+// -----------------------------------------------------------------------------
+//                             Parallel Reduce
+// -----------------------------------------------------------------------------
+
+    // Computes reduce(... reduce(identity, map(0)) ..., map(count - 1)) across the job system.
+    // Each participant reduces into a private accumulator, and accumulators are combined with reduce on completion,
+    // so reduce must be associative and commutative.
+    template<typename T, typename MapFn, typename ReduceFn>
+    T ParallelReduce(JobSystem& system, u64 count, u64 grain, T identity, MapFn&& map, ReduceFn&& reduce)
+    {
+        grain = std::max(grain, u64(1));
+        if (count <= grain || system.GetWorkerCount() == 0) {
+            T result = std::move(identity);
+            for (u64 i = 0; i < count; ++i) {
+                result = reduce(std::move(result), map(i));
+            }
+            return result;
+        }
+
+        // One accumulator for the caller and each potential helper, each only touched by its own participant
+        std::vector<std::optional<T>> partials(system.GetWorkerCount() + 1);
+
+        auto run = [&](u64 first, u64 last, u32 slot) {
+            auto& acc = partials[slot];
+            if (!acc) {
+                acc.emplace(identity);
+            }
+            for (u64 i = first; i < last; ++i) {
+                acc = reduce(std::move(*acc), map(i));
+            }
+        };
+
+        detail::RunParallelLoop(system, count, grain, run);
+
+        T result = std::move(identity);
+        for (auto& partial : partials) {
+            if (partial) {
+                result = reduce(std::move(result), std::move(*partial));
+            }
+        }
+        return result;
+    }
+
+    template<typename T, typename MapFn, typename ReduceFn>
+    T ParallelReduce(u64 count, u64 grain, T identity, MapFn&& map, ReduceFn&& reduce)
+    {
+        return ParallelReduce(JobSystem::GetDefault(), count, grain, std::move(identity),
+            std::forward<MapFn>(map), std::forward<ReduceFn>(reduce));
+    }
+
+// -----------------------------------------------------------------------------
+//                              Parallel Sort
+// -----------------------------------------------------------------------------
+
+    // Sorts independent blocks in parallel, then merges pairs of neighbouring blocks in parallel passes
+    template<std::random_access_iterator It, typename Compare = std::less<>>
+    void ParallelSort(JobSystem& system, It first, It last, Compare comp = {}, u64 grain = 4096)
+    {
+        u64 count = u64(std::distance(first, last));
+        grain = std::max(grain, u64(1));
+        if (count <= grain || system.GetWorkerCount() == 0) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        u64 blocks = std::min((count + grain - 1) / grain, u64(system.GetWorkerCount() + 1) * 4);
+        u64 block_size = (count + blocks - 1) / blocks;
+        blocks = (count + block_size - 1) / block_size;
+
+        auto BlockBegin = [&](u64 block) { return first + std::min(block * block_size, count); };
+
+        ParallelFor(system, blocks, 1, [&](u64 block) {
+            std::sort(BlockBegin(block), BlockBegin(block + 1), comp);
+        });
+
+        for (u64 width = 1; width < blocks; width *= 2) {
+            u64 pairs = (blocks + 2 * width - 1) / (2 * width);
+            ParallelFor(system, pairs, 1, [&](u64 pair) {
+                u64 left = pair * 2 * width;
+                u64 right = left + width;
+                if (right >= blocks) {
+                    return;
+                }
+                std::inplace_merge(BlockBegin(left), BlockBegin(right), BlockBegin(std::min(right + width, blocks)), comp);
+            });
+        }
+    }
+
+    template<std::random_access_iterator It, typename Compare = std::less<>>
+    void ParallelSort(It first, It last, Compare comp = {}, u64 grain = 4096)
+    {
+        ParallelSort(JobSystem::GetDefault(), first, last, std::move(comp), grain);
+    }
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Trace.hpp"
+
+// Profiling zones compile away unless NOVA_PROFILE is set to 1, and then cost a relaxed load and a branch per zone
+// until the profiler is enabled
+#ifndef NOVA_PROFILE
+#  define NOVA_PROFILE 0
+#endif
+
+namespace nova
+{
+    struct ProfileZoneStats
+    {
+        std::string name;
+        u64        count = 0;
+        u64        total = 0; // All durations in nanoseconds
+        u64          min = UINT64_MAX;
+        u64          max = 0;
+        u64          p50 = 0;
+        u64          p95 = 0;
+        u64          p99 = 0;
+    };
+
+// -----------------------------------------------------------------------------
+//                                 Profiler
+// -----------------------------------------------------------------------------
+
+    // Hierarchical CPU profiling zones.
+    //
+    // Each thread records completed zones into its own fixed size ring, overwriting the oldest zones once full, so
+    // recording never allocates or takes a lock after a thread's first zone. Zones nest by time, and record their
+    // depth for aggregation. Frame markers are recorded into a shared ring of timestamps.
+    //
+    // Rings may be read while threads are recording. The writer announces the slot it is about to overwrite before
+    // writing it, and readers discard any slot that may have been overwritten while they were copying it.
+
+    class Profiler
+    {
+        struct Event
+        {
+            u64  name; // const char*
+            u64 begin;
+            u64   end;
+            u64 depth;
+        };
+
+        struct Buffer
+        {
+            static constexpr u64 Capacity = 1 << 16;
+
+            std::unique_ptr<Event[]> events{ new Event[Capacity] };
+            std::atomic<u64>            claimed = 0;
+            std::atomic<u64>               head = 0;
+            u32                           depth = 0; // Owning thread only
+            std::string                    name;
+            u32                             tid = 0;
+        };
+
+        using Registry = detail::TraceBufferRegistry<Buffer>;
+
+        struct Snapshot
+        {
+            Buffer*           buffer;
+            std::vector<Event> events;
+        };
+
+        static constexpr u64 FrameCapacity = 1 << 12;
+
+        static inline std::array<std::atomic<u64>, FrameCapacity> frames{};
+        static inline std::atomic<u64>                       frame_head = 0;
+
+        static inline std::atomic<bool> enabled = false;
+
+        static void Store(u64& field, u64 value) noexcept
+        {
+            std::atomic_ref(field).store(value, std::memory_order_relaxed);
+        }
+
+        static u64 Load(u64& field) noexcept
+        {
+            return std::atomic_ref(field).load(std::memory_order_relaxed);
+        }
+
+        // Copies every event that is still intact, oldest first
+        static std::vector<Snapshot> Capture()
+        {
+            std::vector<Snapshot> snapshots;
+            Registry::Get().ForEach([&](Buffer& buffer) {
+                u64 head = buffer.head.load(std::memory_order_acquire);
+                u64 first = head > Buffer::Capacity ? head - Buffer::Capacity : 0;
+
+                auto& snapshot = snapshots.emplace_back(&buffer);
+                snapshot.events.reserve(head - first);
+                for (u64 i = first; i < head; ++i) {
+                    auto& event = buffer.events[i % Buffer::Capacity];
+                    snapshot.events.push_back({ Load(event.name), Load(event.begin), Load(event.end), Load(event.depth) });
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                u64 claimed = buffer.claimed.load(std::memory_order_relaxed);
+                u64 valid = claimed > Buffer::Capacity ? claimed - Buffer::Capacity : 0;
+                if (valid > first) {
+                    snapshot.events.erase(snapshot.events.begin(), snapshot.events.begin() + std::min(valid - first, head - first));
+                }
+            });
+            return snapshots;
+        }
+
+        static std::vector<u64> CaptureFrames()
+        {
+            u64 head = frame_head.load(std::memory_order_acquire);
+            u64 first = head > FrameCapacity ? head - FrameCapacity : 0;
+
+            std::vector<u64> times;
+            for (u64 i = first; i < head; ++i) {
+                if (u64 time = frames[i % FrameCapacity].load(std::memory_order_relaxed)) {
+                    times.push_back(time);
+                }
+            }
+            std::ranges::sort(times);
+            return times;
+        }
+
+    public:
+        static bool IsEnabled() noexcept
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        static void Enable(bool state = true) noexcept
+        {
+            enabled.store(state, std::memory_order_relaxed);
+        }
+
+        static u64 Now() noexcept
+        {
+            return TraceNow();
+        }
+
+        // Returns the zone start time, or 0 if profiling is disabled
+        static u64 BeginZone() noexcept
+        {
+            if (!IsEnabled()) {
+                return 0;
+            }
+
+            Buffer* buffer = Registry::AcquireLocal();
+            buffer->depth++;
+            return Now();
+        }
+
+        static void EndZone(const char* name, u64 begin) noexcept
+        {
+            u64 end = Now();
+            Buffer* buffer = Registry::Local();
+            u32 depth = --buffer->depth;
+
+            u64 index = buffer->head.load(std::memory_order_relaxed);
+            buffer->claimed.store(index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            auto& event = buffer->events[index % Buffer::Capacity];
+            Store(event.name, u64(uintptr_t(name)));
+            Store(event.begin, begin);
+            Store(event.end, end);
+            Store(event.depth, depth);
+
+            buffer->head.store(index + 1, std::memory_order_release);
+        }
+
+        static void MarkFrame() noexcept
+        {
+            if (!IsEnabled()) {
+                return;
+            }
+
+            u64 index = frame_head.fetch_add(1, std::memory_order_acq_rel);
+            frames[index % FrameCapacity].store(Now(), std::memory_order_relaxed);
+        }
+
+        // Discards all recorded zones and frames, must not be called while any thread may be recording
+        static void Clear()
+        {
+            Registry::Get().ForEach([](Buffer& buffer) {
+                buffer.claimed = 0;
+                buffer.head = 0;
+            });
+            for (auto& frame : frames) {
+                frame = 0;
+            }
+            frame_head = 0;
+        }
+
+// -----------------------------------------------------------------------------
+
+        // Aggregates all zones still held in the rings that started at or after `since`, by name.
+        // Intervals between frame markers are reported as a zone named "Frame". Sorted by total time.
+        static std::vector<ProfileZoneStats> GetStats(u64 since = 0)
+        {
+            HashMap<std::string_view, std::vector<u64>> durations;
+            for (auto& snapshot : Capture()) {
+                for (auto& event : snapshot.events) {
+                    if (event.begin >= since) {
+                        durations[reinterpret_cast<const char*>(uintptr_t(event.name))].push_back(event.end - event.begin);
+                    }
+                }
+            }
+
+            auto times = CaptureFrames();
+            for (usz i = 1; i < times.size(); ++i) {
+                if (times[i - 1] >= since) {
+                    durations["Frame"].push_back(times[i] - times[i - 1]);
+                }
+            }
+
+            std::vector<ProfileZoneStats> stats;
+            stats.reserve(durations.size());
+            for (auto&[name, values] : durations) {
+                std::ranges::sort(values);
+                auto Percentile = [&](f64 p) {
+                    return values[std::min(values.size() - 1, usz(p * f64(values.size())))];
+                };
+
+                auto& zone = stats.emplace_back();
+                zone.name = name;
+                zone.count = values.size();
+                zone.total = std::accumulate(values.begin(), values.end(), u64(0));
+                zone.min = values.front();
+                zone.max = values.back();
+                zone.p50 = Percentile(0.50);
+                zone.p95 = Percentile(0.95);
+                zone.p99 = Percentile(0.99);
+            }
+
+            std::ranges::sort(stats, std::greater{}, &ProfileZoneStats::total);
+            return stats;
+        }
+
+        static void LogStats(u64 since = 0)
+        {
+            auto Duration = [](u64 ns) {
+                return DurationToString(std::chrono::nanoseconds(ns));
+            };
+
+            Log("{:<32} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}", "Zone", "Count", "Total", "Min", "p50", "p95", "p99", "Max");
+            for (auto& zone : GetStats(since)) {
+                Log("{:<32} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}", zone.name, zone.count,
+                    Duration(zone.total), Duration(zone.min), Duration(zone.p50), Duration(zone.p95), Duration(zone.p99), Duration(zone.max));
+            }
+        }
+
+        // Writes all zones and frame markers still held in the rings in the Chrome trace event format
+        static void WriteChromeTrace(JsonWriter& json)
+        {
+            auto snapshots = Capture();
+            auto times = CaptureFrames();
+
+            u64 origin = times.empty() ? UINT64_MAX : times.front();
+            for (auto& snapshot : snapshots) {
+                if (!snapshot.events.empty()) {
+                    origin = std::min(origin, snapshot.events.front().begin);
+                }
+            }
+
+            ChromeTraceWriter writer{json, origin};
+            for (auto& snapshot : snapshots) {
+                writer.ThreadName(snapshot.buffer->tid, snapshot.buffer->name);
+                for (auto& event : snapshot.events) {
+                    writer.Complete(reinterpret_cast<const char*>(uintptr_t(event.name)), "zone", snapshot.buffer->tid, event.begin, event.end);
+                }
+            }
+
+            for (u64 time : times) {
+                writer.BeginEvent("Frame", "frame", "i", 0, time)["s"].String("g");
+                writer.EndEvent();
+            }
+        }
+
+        static void WriteChromeTrace(std::ostream& out)
+        {
+            JsonWriter json{out};
+            WriteChromeTrace(json);
+        }
+    };
+
+    // Records the enclosing scope as a zone, the name must outlive the profiler (typically a string literal)
+
+    class ProfileZone
+    {
+        const char* name;
+        u64        begin;
+
+    public:
+        explicit ProfileZone(const char* _name) noexcept
+            : name(_name)
+            , begin(Profiler::BeginZone())
+        {}
+
+        ~ProfileZone() noexcept
+        {
+            if (begin) {
+                Profiler::EndZone(name, begin);
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        auto operator=(const ProfileZone&) = delete;
+        ProfileZone(ProfileZone&&) = delete;
+        auto operator=(ProfileZone&&) = delete;
+    };
+}
+
+#if NOVA_PROFILE
+#  define NOVA_PROFILE_SCOPE(name) ::nova::ProfileZone NOVA_UNIQUE_VAR()(name)
+#  define NOVA_PROFILE_FRAME()     ::nova::Profiler::MarkFrame()
+#else
+#  define NOVA_PROFILE_SCOPE(name) do {} while (0)
+#  define NOVA_PROFILE_FRAME()     do {} while (0)
+#endif
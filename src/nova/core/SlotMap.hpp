@@ -0,0 +1,339 @@
+#pragma once
+
+#include "Core.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                                 Slot Key
+// -----------------------------------------------------------------------------
+
+    // Index into a slot map tagged with the generation of the slot at insertion. The generation of a slot is odd
+    // while it is occupied and is bumped on every insert and erase, so a key outliving its value never matches
+
+    struct SlotKey
+    {
+        static constexpr u32 InvalidIndex = UINT32_MAX;
+
+        u32      index = InvalidIndex;
+        u32 generation = 0;
+
+        explicit operator bool() const noexcept { return index != InvalidIndex; }
+
+        bool operator==(const SlotKey&) const noexcept = default;
+    };
+
+// -----------------------------------------------------------------------------
+//                                 Slot Map
+// -----------------------------------------------------------------------------
+
+    // Generation checked object pool with O(1) insert, lookup and erase.
+    //
+    // Slots are stored in fixed size pages that are never moved or freed until the map is destroyed, so pointers to
+    // values stay valid for as long as the value is live and can be handed out directly. Erased slots are threaded
+    // onto an intrusive free list and reused most-recently-freed first, keeping hot slots hot in cache.
+    //
+    // Not thread safe, callers that share a map must provide their own synchronization.
+
+    template<typename T, u32 PageShift = 8>
+    class SlotMap
+    {
+        static constexpr u32 PageSize = 1u << PageShift;
+        static constexpr u32 PageMask = PageSize - 1;
+
+        struct Slot
+        {
+            alignas(T) std::byte storage[sizeof(T)];
+            u32 generation;
+            u32      index;
+            u32  next_free;
+
+            T* Get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+            bool IsLive() const noexcept { return generation & 1; }
+        };
+
+        std::vector<std::unique_ptr<Slot[]>> pages;
+
+        u32 free_head = SlotKey::InvalidIndex;
+        u32  capacity = 0;
+        u32     count = 0;
+
+    public:
+        SlotMap() = default;
+
+        ~SlotMap()
+        {
+            Clear();
+        }
+
+        SlotMap(SlotMap&& other) noexcept
+            : pages(std::move(other.pages))
+            , free_head(std::exchange(other.free_head, SlotKey::InvalidIndex))
+            , capacity(std::exchange(other.capacity, 0))
+            , count(std::exchange(other.count, 0))
+        {}
+
+        SlotMap& operator=(SlotMap&& other) noexcept
+        {
+            if (this != &other) {
+                this->~SlotMap();
+                new (this) SlotMap(std::move(other));
+            }
+            return *this;
+        }
+
+        SlotMap(const SlotMap&) = delete;
+        SlotMap& operator=(const SlotMap&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        template<typename... Args>
+        SlotKey Insert(Args&&... args)
+        {
+            if (free_head == SlotKey::InvalidIndex) {
+                AddPage();
+            }
+
+            Slot& slot = GetSlot(free_head);
+            new (slot.storage) T(std::forward<Args>(args)...);
+            free_head = slot.next_free;
+            slot.generation++;
+            count++;
+
+            return { slot.index, slot.generation };
+        }
+
+        // Inserts a value and returns its stable address, recover the key later with KeyOf
+        template<typename... Args>
+        T* Emplace(Args&&... args)
+        {
+            return GetSlot(Insert(std::forward<Args>(args)...).index).Get();
+        }
+
+        void Erase(SlotKey key)
+        {
+            NOVA_ASSERT(Contains(key), "SlotMap::Erase with stale key (index = {}, generation = {})", key.index, key.generation);
+
+            Slot& slot = GetSlot(key.index);
+            slot.Get()->~T();
+            slot.generation++;
+            slot.next_free = free_head;
+            free_head = key.index;
+            count--;
+        }
+
+        void Clear()
+        {
+            if (count == 0) {
+                return;
+            }
+
+            for (u32 i = 0; i < capacity; ++i) {
+                Slot& slot = GetSlot(i);
+                if (slot.IsLive()) {
+                    Erase({ i, slot.generation });
+                }
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        bool Contains(SlotKey key) const noexcept
+        {
+            return key.index < capacity && GetSlot(key.index).generation == key.generation && (key.generation & 1);
+        }
+
+        // Returns nullptr if the key is stale
+        T* Get(SlotKey key) noexcept
+        {
+            return Contains(key) ? GetSlot(key.index).Get() : nullptr;
+        }
+
+        const T* Get(SlotKey key) const noexcept
+        {
+            return const_cast<SlotMap*>(this)->Get(key);
+        }
+
+        T& operator[](SlotKey key)
+        {
+            NOVA_ASSERT(Contains(key), "SlotMap access with stale key (index = {}, generation = {})", key.index, key.generation);
+            return *GetSlot(key.index).Get();
+        }
+
+        const T& operator[](SlotKey key) const
+        {
+            return const_cast<SlotMap&>(*this)[key];
+        }
+
+        // Recovers the key of a value from its address. The key is only meaningful while the value is live, after
+        // erasure it reports the current generation of the slot which Contains rejects. Only the slot header is read,
+        // so this is safe to call on the address of an erased value
+        static SlotKey KeyOf(const T* value) noexcept
+        {
+            auto* slot = reinterpret_cast<const Slot*>(reinterpret_cast<const std::byte*>(value) - offsetof(Slot, storage));
+            return { slot->index, slot->generation };
+        }
+
+        u32 Size() const noexcept
+        {
+            return count;
+        }
+
+        u32 Capacity() const noexcept
+        {
+            return capacity;
+        }
+
+        bool IsEmpty() const noexcept
+        {
+            return count == 0;
+        }
+
+        // Visits every live value in index order as fn(SlotKey, T&)
+        template<typename Fn>
+        void ForEach(Fn&& fn)
+        {
+            for (auto& page : pages) {
+                for (u32 i = 0; i < PageSize; ++i) {
+                    Slot& slot = page[i];
+                    if (slot.IsLive()) {
+                        fn(SlotKey{ slot.index, slot.generation }, *slot.Get());
+                    }
+                }
+            }
+        }
+
+    private:
+        Slot& GetSlot(u32 index) const noexcept
+        {
+            return pages[index >> PageShift][index & PageMask];
+        }
+
+        NOVA_NO_INLINE
+        void AddPage()
+        {
+            if (capacity > SlotKey::InvalidIndex - PageSize) {
+                NOVA_THROW("SlotMap exceeded maximum capacity");
+            }
+
+            auto& page = pages.emplace_back(new Slot[PageSize]);
+
+            // Thread the new slots in ascending order so that a fresh map hands out indices 0, 1, 2, ...
+            for (u32 i = 0; i < PageSize; ++i) {
+                page[i].generation = 0;
+                page[i].index = capacity + i;
+                page[i].next_free = i + 1 < PageSize ? capacity + i + 1 : free_head;
+            }
+            free_head = capacity;
+            capacity += PageSize;
+        }
+    };
+}
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                         Concurrent Index Free List
+// -----------------------------------------------------------------------------
+
+    // Lock-free allocator of generation tagged indices in [0, capacity).
+    //
+    // Released indices are pushed onto a Treiber stack whose head packs the top index with a counter that is bumped
+    // on every push and pop, so a thread that read a stale successor can never swing the head to it (ABA). Indices
+    // that have never been handed out are claimed from a bump counter, which keeps the set of used indices dense.
+    //
+    // Each index carries a generation in the same scheme as SlotMap, releasing a key twice or releasing a key
+    // from a previous generation throws instead of corrupting the free list.
+
+    class ConcurrentIndexFreeList
+    {
+        struct Entry
+        {
+            std::atomic<u32>       next = SlotKey::InvalidIndex;
+            std::atomic<u32> generation = 0;
+        };
+
+        std::unique_ptr<Entry[]> entries;
+        u32                     capacity = 0;
+
+        alignas(64) std::atomic<u64>     head = Pack(0, SlotKey::InvalidIndex);
+        alignas(64) std::atomic<u32> next_index = 0;
+
+    public:
+        ConcurrentIndexFreeList() = default;
+
+        explicit ConcurrentIndexFreeList(u32 _capacity)
+        {
+            Init(_capacity);
+        }
+
+        // Not thread safe, discards all outstanding indices
+        void Init(u32 _capacity)
+        {
+            entries.reset(new Entry[_capacity]);
+            capacity = _capacity;
+            head.store(Pack(0, SlotKey::InvalidIndex), std::memory_order::relaxed);
+            next_index.store(0, std::memory_order::relaxed);
+        }
+
+        SlotKey Acquire()
+        {
+            u64 top = head.load(std::memory_order::acquire);
+            while (Index(top) != SlotKey::InvalidIndex) {
+                u32 next = entries[Index(top)].next.load(std::memory_order::relaxed);
+                if (head.compare_exchange_weak(top, Pack(Tag(top) + 1, next), std::memory_order::acquire, std::memory_order::acquire)) {
+                    return Claim(Index(top));
+                }
+            }
+
+            u32 index = next_index.fetch_add(1, std::memory_order::relaxed);
+            if (index >= capacity) {
+                next_index.fetch_sub(1, std::memory_order::relaxed);
+                NOVA_THROW("ConcurrentIndexFreeList exhausted all {} indices", capacity);
+            }
+            return Claim(index);
+        }
+
+        void Release(SlotKey key)
+        {
+            u32 generation = key.generation;
+            if (key.index >= capacity || !(generation & 1)
+                    || !entries[key.index].generation.compare_exchange_strong(generation, generation + 1, std::memory_order::relaxed)) {
+                NOVA_THROW("ConcurrentIndexFreeList::Release with stale key (index = {}, generation = {})", key.index, key.generation);
+            }
+
+            Entry& entry = entries[key.index];
+            u64 top = head.load(std::memory_order::relaxed);
+            do {
+                entry.next.store(Index(top), std::memory_order::relaxed);
+            } while (!head.compare_exchange_weak(top, Pack(Tag(top) + 1, key.index), std::memory_order::release, std::memory_order::relaxed));
+        }
+
+        bool Contains(SlotKey key) const noexcept
+        {
+            return key.index < capacity && (key.generation & 1)
+                && entries[key.index].generation.load(std::memory_order::relaxed) == key.generation;
+        }
+
+        u32 Capacity() const noexcept
+        {
+            return capacity;
+        }
+
+        // Number of indices that have ever been handed out, an upper bound on the highest live index + 1
+        u32 HighWaterMark() const noexcept
+        {
+            return std::min(next_index.load(std::memory_order::relaxed), capacity);
+        }
+
+    private:
+        static constexpr u64 Pack(u32 tag, u32 index) noexcept { return u64(tag) << 32 | index; }
+        static constexpr u32  Tag(u64 packed)         noexcept { return u32(packed >> 32); }
+        static constexpr u32 Index(u64 packed)        noexcept { return u32(packed); }
+
+        SlotKey Claim(u32 index) noexcept
+        {
+            return { index, entries[index].generation.fetch_add(1, std::memory_order::relaxed) + 1 };
+        }
+    };
+}
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "JobSystem.hpp"
+
+namespace nova
+{
+    template<typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        inline JobSystem& CurrentJobSystem()
+        {
+            return JobWorkerState.system ? *JobWorkerState.system : JobSystem::GetDefault();
+        }
+
+        template<typename Promise>
+        JobSystem& ResumeSystem(std::coroutine_handle<Promise> handle)
+        {
+            if constexpr (requires { handle.promise().system; }) {
+                if (handle.promise().system) {
+                    return *handle.promise().system;
+                }
+            }
+            return CurrentJobSystem();
+        }
+
+// -----------------------------------------------------------------------------
+//                              Task promise
+// -----------------------------------------------------------------------------
+
+        // A task completes exactly once, and may be awaited by at most one coroutine or blocking waiter.
+        // The waiter slot holds either a coroutine address, a Barrier tagged in the low bit, or Completed.
+
+        struct TaskPromiseBase
+        {
+            static inline void* const Completed = reinterpret_cast<void*>(~uintptr_t(0));
+
+            JobSystem*               system = nullptr;
+            std::atomic<void*>       waiter = nullptr;
+            std::exception_ptr    exception;
+            bool                   detached = false;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    if (promise.detached) {
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+
+                    void* waiter = promise.waiter.exchange(Completed, std::memory_order_acq_rel);
+                    if (!waiter) {
+                        return std::noop_coroutine();
+                    }
+
+                    if (uintptr_t(waiter) & 1) {
+                        // Adopt the reference held by the waiter slot, the blocking waiter may return before Signal does
+                        Ref<Barrier> barrier = static_cast<Barrier*>(reinterpret_cast<void*>(uintptr_t(waiter) & ~uintptr_t(1)));
+                        barrier->RefCounted_Release();
+                        barrier->Signal();
+                        return std::noop_coroutine();
+                    }
+
+                    // Continue the awaiting coroutine directly on this thread
+                    return std::coroutine_handle<>::from_address(waiter);
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter          final_suspend() noexcept { return {}; }
+
+            void unhandled_exception() noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            // Returns false if the task has already completed
+            bool SetWaiter(void* value) noexcept
+            {
+                void* expected = nullptr;
+                return waiter.compare_exchange_strong(expected, value, std::memory_order_acq_rel);
+            }
+
+            bool IsComplete() const noexcept
+            {
+                return waiter.load(std::memory_order_acquire) == Completed;
+            }
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename V>
+            void return_value(V&& v)
+            {
+                value.emplace(std::forward<V>(v));
+            }
+
+            T Result()
+            {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void Result()
+            {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+//                                  Task
+// -----------------------------------------------------------------------------
+
+    // Lazily started coroutine that runs on a JobSystem.
+    //
+    // Awaiting a task that has not been started runs it inline on the awaiting thread, and the awaiting
+    // coroutine resumes directly on whichever thread completes it. Start() submits the task to a job system
+    // so that several tasks may run concurrently before being awaited.
+
+    template<typename T>
+    class Task
+    {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+        bool                               started = false;
+
+    public:
+        Task() = default;
+
+        explicit Task(std::coroutine_handle<promise_type> _handle) noexcept
+            : handle(_handle)
+        {}
+
+        Task(Task&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr))
+            , started(other.started)
+        {}
+
+        Task& operator=(Task&& other) noexcept
+        {
+            Task moved = std::move(other);
+            std::swap(handle, moved.handle);
+            std::swap(started, moved.started);
+            return *this;
+        }
+
+        ~Task()
+        {
+            if (handle) {
+                if (started && !handle.promise().IsComplete()) {
+                    // Destroying a running task would free its frame out from under it, wait for completion
+                    Wait();
+                }
+                handle.destroy();
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return bool(handle);
+        }
+
+        bool IsComplete() const noexcept
+        {
+            return handle && handle.promise().IsComplete();
+        }
+
+        // Submits the task to a job system, it may then complete before being awaited
+        Task& Start(JobSystem& system)
+        {
+            NOVA_ASSERT(handle && !started, "Task has already been started");
+            started = true;
+            handle.promise().system = &system;
+            system.Submit(handle);
+            return *this;
+        }
+
+        Task& Start()
+        {
+            return Start(detail::CurrentJobSystem());
+        }
+
+        // Starts the task and releases ownership, the coroutine frame is destroyed on completion.
+        // Exceptions thrown by detached tasks are discarded.
+        void Detach(JobSystem& system)
+        {
+            NOVA_ASSERT(handle && !started, "Only tasks that have not been started may be detached");
+            auto h = std::exchange(handle, nullptr);
+            h.promise().detached = true;
+            h.promise().system = &system;
+            system.Submit(h);
+        }
+
+        void Detach()
+        {
+            Detach(detail::CurrentJobSystem());
+        }
+
+        // Blocks until complete, executing other jobs when called from a worker thread
+        void Wait()
+        {
+            NOVA_ASSERT(handle, "Waiting on empty task");
+
+            if (!started) {
+                Start();
+            }
+
+            if (handle.promise().IsComplete()) {
+                return;
+            }
+
+            auto barrier = Barrier::Create();
+            barrier->Acquire();
+
+            // The waiter slot holds its own reference, released by the completing thread
+            barrier->RefCounted_Acquire();
+            if (handle.promise().SetWaiter(reinterpret_cast<void*>(uintptr_t(barrier.Raw()) | 1))) {
+                barrier->Wait();
+            } else {
+                barrier->RefCounted_Release();
+            }
+        }
+
+        T Get()
+        {
+            Wait();
+            return handle.promise().Result();
+        }
+
+        struct Awaiter
+        {
+            Task& task;
+
+            bool await_ready() noexcept
+            {
+                return task.started && task.handle.promise().IsComplete();
+            }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+            {
+                auto& promise = task.handle.promise();
+
+                if (!task.started) {
+                    // Run inline by symmetric transfer, inheriting the job system of the awaiting coroutine
+                    task.started = true;
+                    promise.system = &detail::ResumeSystem(awaiting);
+                    promise.waiter.store(awaiting.address(), std::memory_order_relaxed);
+                    return task.handle;
+                }
+
+                if (!promise.SetWaiter(awaiting.address())) {
+                    // Completed between await_ready and now
+                    return awaiting;
+                }
+
+                return std::noop_coroutine();
+            }
+
+            T await_resume()
+            {
+                return task.handle.promise().Result();
+            }
+        };
+
+        Awaiter operator co_await() noexcept
+        {
+            return Awaiter{*this};
+        }
+    };
+
+    namespace detail
+    {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept
+        {
+            return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+        }
+
+        inline
+        Task<void> TaskPromise<void>::get_return_object() noexcept
+        {
+            return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                                Awaitables
+// -----------------------------------------------------------------------------
+
+    // Suspends until the barrier is signalled, then resumes on the awaiting task's job system
+
+    struct BarrierAwaiter
+    {
+        Barrier&                     barrier;
+        detail::BarrierContinuation continuation;
+
+        bool await_ready() noexcept
+        {
+            return barrier.counter.load(std::memory_order_acquire) == 0;
+        }
+
+        template<typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> awaiting)
+        {
+            continuation.system = &detail::ResumeSystem(awaiting);
+            continuation.handle = awaiting;
+            return barrier.Suspend(continuation);
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    inline
+    BarrierAwaiter operator co_await(Barrier& barrier) noexcept
+    {
+        return { barrier };
+    }
+
+    inline
+    BarrierAwaiter operator co_await(const Ref<Barrier>& barrier) noexcept
+    {
+        return { *barrier };
+    }
+
+    // Moves the awaiting coroutine onto a job system
+
+    struct ScheduleAwaiter
+    {
+        JobSystem& system;
+
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) { system.Submit(awaiting); }
+        void await_resume() noexcept {}
+    };
+
+    inline
+    ScheduleAwaiter Schedule(JobSystem& system) noexcept
+    {
+        return { system };
+    }
+
+    // Moves the awaiting coroutine onto the I/O workers of a job system, where it may block
+
+    struct ScheduleIOAwaiter
+    {
+        JobSystem& system;
+
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) { system.SubmitIO(awaiting); }
+        void await_resume() noexcept {}
+    };
+
+    inline
+    ScheduleIOAwaiter ScheduleIO(JobSystem& system) noexcept
+    {
+        return { system };
+    }
+
+    // Reschedules the awaiting coroutine behind other queued work
+
+    struct YieldAwaiter
+    {
+        bool await_ready() noexcept { return false; }
+
+        template<typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> awaiting)
+        {
+            detail::ResumeSystem(awaiting).Yield(awaiting);
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    inline
+    YieldAwaiter Yield() noexcept
+    {
+        return {};
+    }
+
+    // Any value with a non-blocking Check() (e.g. gpu SyncPoint and Fence) can be awaited. The awaiting task is
+    // parked on its job system and rechecked by an idle worker, so workers run other jobs until the value is ready.
+
+    template<typename T>
+    concept Pollable = requires(const T& t) {
+        { t.Check() } -> std::convertible_to<bool>;
+    };
+
+    namespace detail
+    {
+        template<Pollable T>
+        struct PollAwaiter
+        {
+            T pollable;
+
+            bool await_ready()
+            {
+                return pollable.Check();
+            }
+
+            template<typename Promise>
+            void await_suspend(std::coroutine_handle<Promise> awaiting)
+            {
+                detail::ResumeSystem(awaiting).Park(awaiting, [](const void* state) {
+                    return bool(static_cast<const T*>(state)->Check());
+                }, &pollable);
+            }
+
+            void await_resume() noexcept {}
+        };
+    }
+
+    template<Pollable T>
+    detail::PollAwaiter<T> operator co_await(const T& pollable)
+    {
+        return { pollable };
+    }
+}
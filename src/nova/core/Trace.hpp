@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Core.hpp"
+#include "JsonWriter.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                               Trace Threads
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        inline thread_local std::string TraceThreadName;
+    }
+
+    // Name used for the calling thread in exported traces and profiles, must be set before it first records
+    inline
+    void SetTraceThreadName(std::string name)
+    {
+        detail::TraceThreadName = std::move(name);
+    }
+
+    // Monotonic timestamp in nanoseconds shared by all recorders, so their traces can be lined up
+    inline
+    u64 TraceNow() noexcept
+    {
+        return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    namespace detail
+    {
+        // Process-wide list of per-thread recording buffers, one list per Buffer type.
+        //
+        // Each thread lazily registers a single Buffer on first use and keeps a thread local pointer to it, so
+        // recording only takes the registry lock once per thread. Buffers are never freed, readers walk them under
+        // the lock while their owners keep recording. Buffer must be default constructible and have `name` and `tid`.
+
+        template<typename Buffer>
+        class TraceBufferRegistry
+        {
+            std::mutex                           mutex;
+            std::vector<std::unique_ptr<Buffer>> buffers;
+
+            static inline thread_local Buffer* local = nullptr;
+
+        public:
+            static TraceBufferRegistry& Get()
+            {
+                return LeakedInstance<TraceBufferRegistry>();
+            }
+
+            // Buffer of the calling thread, or nullptr if it has not recorded yet
+            static Buffer* Local() noexcept
+            {
+                return local;
+            }
+
+            static Buffer* AcquireLocal()
+            {
+                return local ? local : Get().Register();
+            }
+
+            // Visits every registered buffer in registration order as fn(Buffer&), holding the registry lock
+            template<typename Fn>
+            void ForEach(Fn&& fn)
+            {
+                std::scoped_lock lock{mutex};
+                for (auto& buffer : buffers) {
+                    fn(*buffer);
+                }
+            }
+
+        private:
+            NOVA_NO_INLINE Buffer* Register()
+            {
+                std::scoped_lock lock{mutex};
+                auto& buffer = buffers.emplace_back(new Buffer);
+                buffer->tid = u32(buffers.size());
+                buffer->name = TraceThreadName.empty() ? Fmt("Thread {}", buffer->tid) : TraceThreadName;
+                return local = buffer.get();
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+//                            Chrome Trace Writer
+// -----------------------------------------------------------------------------
+
+    // Writes events in the Chrome trace event format, as read by chrome://tracing and Perfetto.
+    //
+    // Timestamps are given in nanoseconds and written in microseconds relative to the origin. Begin/EndEvent
+    // bracket a single event so that callers can add their own fields and args in between.
+
+    class ChromeTraceWriter
+    {
+        JsonWriter& writer;
+        u64         origin;
+
+    public:
+        ChromeTraceWriter(JsonWriter& _writer, u64 _origin)
+            : writer(_writer)
+            , origin(_origin)
+        {
+            writer.Object();
+            writer["displayTimeUnit"].String("ns");
+            writer.Key("traceEvents");
+            writer.Array();
+        }
+
+        ~ChromeTraceWriter()
+        {
+            writer.EndArray();
+            writer.EndObject();
+        }
+
+        ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+        auto operator=(const ChromeTraceWriter&) = delete;
+
+        static std::string Micros(u64 ns)
+        {
+            return Fmt("{:.3f}", f64(ns) / 1000.0);
+        }
+
+        void ThreadName(u32 tid, StringView name)
+        {
+            writer.Object();
+            writer["name"].String("thread_name");
+            writer["ph"].String("M");
+            writer["pid"] = 1u;
+            writer["tid"] = tid;
+            writer.Key("args");
+            writer.Object();
+            writer["name"].String(name);
+            writer.EndObject();
+            writer.EndObject();
+        }
+
+        // Opens an event with the common fields. Phase is "X" for complete events and "i" for instants
+        JsonWriter& BeginEvent(StringView name, StringView category, StringView phase, u32 tid, u64 time)
+        {
+            writer.Object();
+            writer["name"].String(name);
+            writer["cat"].String(category);
+            writer["ph"].String(phase);
+            writer["pid"] = 1u;
+            writer["tid"] = tid;
+            writer.Key("ts").Value(Micros(time - origin));
+            return writer;
+        }
+
+        void EndEvent()
+        {
+            writer.EndObject();
+        }
+
+        // Complete event spanning [begin, end) with no extra fields
+        void Complete(StringView name, StringView category, u32 tid, u64 begin, u64 end)
+        {
+            BeginEvent(name, category, "X", tid, begin).Key("dur").Value(Micros(end - begin));
+            EndEvent();
+        }
+    };
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Core.hpp"
+
+namespace nova
+{
+// -----------------------------------------------------------------------------
+//                              Virtual Vector
+// -----------------------------------------------------------------------------
+
+    // Contiguous growable array over a single reserved range of virtual memory.
+    //
+    // The address range is reserved on first growth and pages are committed in blocks of the commit granularity as
+    // elements are appended, so growing never reallocates or moves elements and pointers to them stay valid for the
+    // lifetime of the container. Only erasing, or reordering the elements in place, changes what a pointer refers to.
+    //
+    // The interface follows std::vector closely enough to be used as a drop-in, with raw pointers as iterators.
+    // Capacity is limited by the reservation, exceeding it throws.
+
+    template<typename T>
+    class VirtualVector
+    {
+    public:
+        static constexpr usz DefaultReserveSize = 4ull * 1024 * 1024 * 1024;
+        static constexpr usz  DefaultCommitSize = 64ull * 1024;
+
+        using value_type      = T;
+        using size_type       = usz;
+        using difference_type = std::ptrdiff_t;
+        using reference       = T&;
+        using const_reference = const T&;
+        using pointer         = T*;
+        using const_pointer   = const T*;
+        using iterator        = T*;
+        using const_iterator  = const T*;
+
+    private:
+        T*               first = nullptr;
+        usz              count = 0;
+        usz          committed = 0; // Bytes
+        usz       reserve_size = DefaultReserveSize; // Bytes
+        usz        commit_size = DefaultCommitSize;
+
+    public:
+        VirtualVector() = default;
+
+        explicit VirtualVector(usz reserve, usz commit_granularity = DefaultCommitSize)
+            : commit_size(std::bit_ceil(std::max(commit_granularity, usz(4096))))
+        {
+            reserve_size = AlignUpPower2(std::max(reserve, commit_size), commit_size);
+        }
+
+        ~VirtualVector()
+        {
+            if (first) {
+                std::destroy_n(first, count);
+                FreeVirtual(FreeType::Release, first);
+            }
+        }
+
+        VirtualVector(VirtualVector&& other) noexcept
+            : first(std::exchange(other.first, nullptr))
+            , count(std::exchange(other.count, 0))
+            , committed(std::exchange(other.committed, 0))
+            , reserve_size(other.reserve_size)
+            , commit_size(other.commit_size)
+        {}
+
+        VirtualVector& operator=(VirtualVector&& other) noexcept
+        {
+            if (this != &other) {
+                this->~VirtualVector();
+                new (this) VirtualVector(std::move(other));
+            }
+            return *this;
+        }
+
+        VirtualVector(const VirtualVector&) = delete;
+        VirtualVector& operator=(const VirtualVector&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        template<typename... Args>
+        NOVA_FORCE_INLINE
+        T& emplace_back(Args&&... args)
+        {
+            if ((count + 1) * sizeof(T) > committed) [[unlikely]] {
+                Grow(count + 1);
+            }
+            T* element = new (first + count) T(std::forward<Args>(args)...);
+            count++;
+            return *element;
+        }
+
+        void push_back(const T& value) { emplace_back(value);            }
+        void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            std::destroy_at(first + --count);
+        }
+
+        // Removes [begin, end), moving the following elements down
+        T* erase(const T* begin_, const T* end_)
+        {
+            T* dst = const_cast<T*>(begin_);
+            T* new_end = std::move(const_cast<T*>(end_), first + count, dst);
+            std::destroy(new_end, first + count);
+            count = usz(new_end - first);
+            return dst;
+        }
+
+        T* erase(const T* pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        void resize(usz size)
+        {
+            if (size < count) {
+                std::destroy(first + size, first + count);
+                count = size;
+                return;
+            }
+            reserve(size);
+            std::uninitialized_value_construct(first + count, first + size);
+            count = size;
+        }
+
+        // Commits pages for at least the given number of elements
+        void reserve(usz size)
+        {
+            if (size * sizeof(T) > committed) {
+                Grow(size);
+            }
+        }
+
+        // Destroys all elements. Committed pages are kept for reuse
+        void clear() noexcept
+        {
+            std::destroy_n(first, count);
+            count = 0;
+        }
+
+        // Decommits all pages above the last element
+        void shrink_to_fit() noexcept
+        {
+            if (!first) {
+                return;
+            }
+
+            usz keep = AlignUpPower2(count * sizeof(T), commit_size);
+            if (keep < committed) {
+                FreeVirtual(FreeType::Decommit, reinterpret_cast<std::byte*>(first) + keep, committed - keep);
+                committed = keep;
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        usz size()     const noexcept { return count;                    }
+        bool empty()   const noexcept { return count == 0;               }
+        usz capacity() const noexcept { return committed / sizeof(T);    }
+        usz max_size() const noexcept { return reserve_size / sizeof(T); }
+
+        T*       data()       noexcept { return first; }
+        const T* data() const noexcept { return first; }
+
+        T*       begin()       noexcept { return first;         }
+        const T* begin() const noexcept { return first;         }
+        T*       end()         noexcept { return first + count; }
+        const T* end()   const noexcept { return first + count; }
+
+        T&       operator[](usz i)       noexcept { return first[i]; }
+        const T& operator[](usz i) const noexcept { return first[i]; }
+
+        T&       front()       noexcept { return first[0];         }
+        const T& front() const noexcept { return first[0];         }
+        T&       back()        noexcept { return first[count - 1]; }
+        const T& back()  const noexcept { return first[count - 1]; }
+
+    private:
+        NOVA_NO_INLINE
+        void Grow(usz size)
+        {
+            if (size > max_size()) {
+                NOVA_THROW("VirtualVector out of reserved memory, requested {} elements of {} with {} reserved",
+                    size, ByteSizeToString(sizeof(T)), ByteSizeToString(reserve_size));
+            }
+
+            if (!first) {
+                first = static_cast<T*>(AllocVirtual(AllocationType::Reserve, reserve_size));
+                if (!first) {
+                    NOVA_THROW("Failed to reserve {} for virtual vector", ByteSizeToString(reserve_size));
+                }
+            }
+
+            usz target = std::min(AlignUpPower2(size * sizeof(T), commit_size), reserve_size);
+            if (!AllocVirtual(AllocationType::Commit, target - committed, reinterpret_cast<std::byte*>(first) + committed)) {
+                NOVA_THROW("Failed to commit {} for virtual vector", ByteSizeToString(target - committed));
+            }
+            committed = target;
+        }
+    };
+}
@@ -18,12 +18,12 @@ namespace {
 
 namespace nova
 {
-    void* AllocVirtual(AllocationType type, usz size)
+    void* AllocVirtual(AllocationType type, usz size, void* address)
     {
         DWORD win_type = {};
         if (type >= AllocationType::Commit)  win_type |= MEM_COMMIT;
         if (type >= AllocationType::Reserve) win_type |= MEM_RESERVE;
-        return VirtualAlloc(nullptr, size, win_type, PAGE_READWRITE);
+        return VirtualAlloc(address, size, win_type, PAGE_READWRITE);
     }
 
     void FreeVirtual(FreeType type, void* ptr, usz size)
@@ -8,13 +8,12 @@ namespace nova::vfs
     {
         struct VirtualFilesystem
         {
-            std::vector<std::unique_ptr<std::string>>                      paths;
-            ankerl::unordered_dense::map<std::string_view, Span<const b8>> files;
+            // Paths are interned and looked up by view, so finding a file never allocates
+            ankerl::unordered_dense::map<String, Span<const b8>, ankerl::unordered_dense::hash<String>, std::equal_to<>> files;
 
-            void Register(std::string name, const void* data, size_t size)
+            void Register(std::string_view name, const void* data, size_t size)
             {
-                std::string_view str = *paths.emplace_back(new std::string(std::move(name)));
-                files[str] = Span((const b8*)data, size);
+                files[String::Intern(name)] = Span((const b8*)data, size);
             }
         };
 
@@ -65,10 +64,10 @@ namespace nova::vfs
         return StringView((const char*)data.data(), data.size());
     }
 
-    void ForEach(std::function<void(StringView, Span<const b8>)> for_each)
+    void ForEach(FunctionRef<void(StringView, Span<const b8>)> for_each)
     {
-        for (auto[path, contents] : detail::GetVFS().files) {
-            for_each(StringView(path), contents);
+        for (auto&[path, contents] : detail::GetVFS().files) {
+            for_each(StringView(path.View()), contents);
         }
     }
 }
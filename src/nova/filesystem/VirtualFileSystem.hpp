@@ -20,6 +20,6 @@ namespace nova
         std::optional<StringView> LoadStringMaybe(StringView path);
         StringView LoadString(StringView path);
 
-        void ForEach(std::function<void(StringView, Span<const b8>)> for_each);
+        void ForEach(FunctionRef<void(StringView, Span<const b8>)> for_each);
     }
 }
\ No newline at end of file
@@ -481,6 +481,7 @@ namespace nova
         u64   value = InvalidFenceValue;
 
         void Wait() const { if (fence) { fence.Wait(value); } }
+        bool Check() const { return !fence || fence.Check(value); }
         u64 Value() const { return (value == InvalidFenceValue && fence) ? fence.PendingValue() : value; }
     };
 
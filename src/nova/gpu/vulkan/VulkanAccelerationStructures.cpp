@@ -4,16 +4,16 @@ namespace nova
 {
     AccelerationStructureBuilder AccelerationStructureBuilder::Create(HContext context)
     {
-        auto impl = new Impl;
-        impl->context = context;
+        auto builder = context->accel_structure_builder_pool.Acquire();
+        builder->context = context;
 
         vkh::Check(context->vkCreateQueryPool(context->device, PtrTo(VkQueryPoolCreateInfo {
             .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
             .queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
             .queryCount = 1,
-        }), context->alloc, &impl->query_pool));
+        }), context->alloc, &builder->query_pool));
 
-        return { impl };
+        return builder;
     }
 
     static
@@ -32,9 +32,11 @@ namespace nova
             return;
         }
 
+        ImplPool<AccelerationStructureBuilder>::Validate(impl, generation);
+
         impl->context->vkDestroyQueryPool(impl->context->device, impl->query_pool, impl->context->alloc);
 
-        delete impl;
+        impl->context->accel_structure_builder_pool.Release(impl, generation);
         impl = nullptr;
     }
 
@@ -190,31 +192,31 @@ namespace nova
 
     AccelerationStructure AccelerationStructure::Create(HContext context, u64 size, AccelerationStructureType type, HBuffer buffer, u64 offset)
     {
-        auto impl = new Impl;
-        impl->context = context;
-        impl->own_buffer = !buffer;
-        if (impl->own_buffer) {
-            impl->buffer = Buffer::Create(context, size, nova::BufferUsage::AccelStorage, nova::BufferFlags::DeviceLocal);
+        auto structure = context->accel_structure_pool.Acquire();
+        structure->context = context;
+        structure->own_buffer = !buffer;
+        if (structure->own_buffer) {
+            structure->buffer = Buffer::Create(context, size, nova::BufferUsage::AccelStorage, nova::BufferFlags::DeviceLocal);
         } else {
-            impl->buffer = buffer;
+            structure->buffer = buffer;
         }
 
         vkh::Check(context->vkCreateAccelerationStructureKHR(context->device, PtrTo(VkAccelerationStructureCreateInfoKHR {
             .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
-            .buffer = impl->buffer->buffer,
+            .buffer = structure->buffer->buffer,
             .offset = offset,
-            .size = impl->buffer->size,
+            .size = structure->buffer->size,
             .type = GetVulkanAccelStructureType(type),
-        }), context->alloc, &impl->structure));
+        }), context->alloc, &structure->structure));
 
-        impl->address = context->vkGetAccelerationStructureDeviceAddressKHR(
+        structure->address = context->vkGetAccelerationStructureDeviceAddressKHR(
             context->device,
             PtrTo(VkAccelerationStructureDeviceAddressInfoKHR {
                 .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
-                .accelerationStructure = impl->structure,
+                .accelerationStructure = structure->structure,
             }));
 
-        return { impl };
+        return structure;
     }
 
     void AccelerationStructure::Destroy()
@@ -223,12 +225,14 @@ namespace nova
             return;
         }
 
+        ImplPool<AccelerationStructure>::Validate(impl, generation);
+
         impl->context->vkDestroyAccelerationStructureKHR(impl->context->device, impl->structure, impl->context->alloc);
         if (impl->own_buffer) {
             impl->buffer.Destroy();
         }
 
-        delete impl;
+        impl->context->accel_structure_pool.Release(impl, generation);
         impl = nullptr;
     }
 
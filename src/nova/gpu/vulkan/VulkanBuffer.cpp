@@ -18,12 +18,11 @@ namespace nova
 
     Buffer Buffer::Create(HContext context, u64 size, BufferUsage usage, BufferFlags flags, void* to_import)
     {
-        auto impl = new Impl;
-        impl->context = context;
-        impl->flags = flags;
-        impl->usage = usage;
+        auto buffer = context->buffer_pool.Acquire();
+        buffer->context = context;
+        buffer->flags = flags;
+        buffer->usage = usage;
 
-        Buffer buffer{ impl };
         if (flags >= BufferFlags::ImportHost) {
             // Log("Importing memory");
 
@@ -72,19 +71,19 @@ namespace nova
                     }),
                     .allocationSize = size_rounded,
                     .memoryTypeIndex = memory_type.value(),
-                }), context->alloc, &impl->imported));
+                }), context->alloc, &buffer->imported));
 
-            vkh::Check(context->vkBindBufferMemory(context->device, buffer->buffer, impl->imported, 0));
+            vkh::Check(context->vkBindBufferMemory(context->device, buffer->buffer, buffer->imported, 0));
 
-            if (impl->flags >= BufferFlags::Addressable) {
-                impl->address = impl->context->vkGetBufferDeviceAddress(impl->context->device, PtrTo(VkBufferDeviceAddressInfo {
+            if (buffer->flags >= BufferFlags::Addressable) {
+                buffer->address = buffer->context->vkGetBufferDeviceAddress(buffer->context->device, PtrTo(VkBufferDeviceAddressInfo {
                     .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-                    .buffer = impl->buffer,
+                    .buffer = buffer->buffer,
                 }));
             }
 
-            if (impl->flags >= BufferFlags::Mapped) {
-                vkh::Check(context->vkMapMemory(context->device, impl->imported, 0, size, 0, &impl->host_address));
+            if (buffer->flags >= BufferFlags::Mapped) {
+                vkh::Check(context->vkMapMemory(context->device, buffer->imported, 0, size, 0, &buffer->host_address));
             }
         } else {
             buffer.Resize(size);
@@ -112,6 +111,8 @@ namespace nova
             return;
         }
 
+        ImplPool<Buffer>::Validate(impl, generation);
+
         if (impl->flags >= BufferFlags::ImportHost) {
             impl->context->vkFreeMemory(impl->context->device, impl->imported, impl->context->alloc);
             impl->context->vkDestroyBuffer(impl->context->device, impl->buffer, impl->context->alloc);
@@ -119,7 +120,7 @@ namespace nova
             ResetBuffer(impl->context, *this);
         }
 
-        delete impl;
+        impl->context->buffer_pool.Release(impl, generation);
         impl = nullptr;
     }
 
@@ -54,17 +54,18 @@ namespace nova
     void Handle<Queue>::Impl::ClearPendingCommandLists()
     {
         auto current_value = fence.CurrentValue();
-        while (!pending_command_lists.empty()) {
-            auto& pending = pending_command_lists.front();
-            if (current_value >= pending.fence_value) {
-                auto* pool = pending.command_list->command_pool;
-                vkh::Check(context->vkResetCommandBuffer(pending.command_list->buffer, 0));
-                pool->available_command_lists.emplace_back(pending.command_list);
-                pending_command_lists.pop_front();
-            } else {
+        auto completed = pending_command_lists.begin();
+        for (; completed != pending_command_lists.end(); ++completed) {
+            if (current_value < completed->fence_value) {
                 break;
             }
+            auto* pool = completed->command_list->command_pool;
+            vkh::Check(context->vkResetCommandBuffer(completed->command_list->buffer, 0));
+            pool->available_command_lists.emplace_back(completed->command_list);
         }
+
+        // Lists complete in submission order, so retire the completed prefix in one step
+        pending_command_lists.erase(pending_command_lists.begin(), completed);
     }
 
     CommandList Queue::Begin() const
@@ -97,6 +98,7 @@ namespace nova
         cmd->using_shader_objects = impl->context->shader_objects;
         cmd->bound_graphics_pipeline = nullptr;
         cmd->shaders.clear();
+        cmd->graphics_key.Set(&GraphicsPipelineKey::shaders, {});
 
         vkh::Check(impl->context->vkBeginCommandBuffer(cmd->buffer, PtrTo(VkCommandBufferBeginInfo {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -844,12 +844,12 @@ Validation-VUID({}): {}
 
         // Deleted graphics pipeline library stages
 
-        for (auto pipeline : impl->vertex_input_stages    | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
-        for (auto pipeline : impl->preraster_stages       | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
-        for (auto pipeline : impl->fragment_shader_stages | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
-        for (auto pipeline : impl->fragment_output_stages | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
-        for (auto pipeline : impl->graphics_pipeline_sets | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
-        for (auto pipeline : impl->compute_pipelines      | std::views::values) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); }
+        impl->vertex_input_stages.ForEach(   [&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
+        impl->preraster_stages.ForEach(      [&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
+        impl->fragment_shader_stages.ForEach([&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
+        impl->fragment_output_stages.ForEach([&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
+        impl->graphics_pipeline_sets.ForEach([&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
+        impl->compute_pipelines.ForEach(     [&](auto&, VkPipeline pipeline) { impl->vkDestroyPipeline(impl->device, pipeline, impl->alloc); });
 
         impl->global_heap.Destroy();
         impl->transfer_manager.Destroy();
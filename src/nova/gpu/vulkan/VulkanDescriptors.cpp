@@ -8,6 +8,9 @@ namespace nova
         image_descriptor_count = _image_descriptor_count;
         sampler_descriptor_count = _sampler_descriptor_count;
 
+        image_handles.Init(image_descriptor_count);
+        sampler_handles.Init(sampler_descriptor_count);
+
         VkDescriptorSetLayoutCreateFlags binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
         if (!context->descriptor_buffers) binding_flags |= VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
 
@@ -6,6 +6,9 @@ namespace nova
     {
         NOVA_STACK_POINT();
 
+        NOVA_ASSERT(info.color_attachments.size() <= MaxColorAttachments,
+            "Too many color attachments: {} (max {})", info.color_attachments.size(), MaxColorAttachments);
+
         impl->color_attachments_formats.resize(info.color_attachments.size());
 
         auto color_attachment_infos = NOVA_STACK_ALLOC(VkRenderingAttachmentInfo, info.color_attachments.size());
@@ -85,6 +88,16 @@ namespace nova
             }
         }
 
+        if (!impl->using_shader_objects) {
+            std::array<Format, MaxColorAttachments> color_formats = {};
+            std::ranges::copy(impl->color_attachments_formats, color_formats.begin());
+            impl->graphics_key.Set(&GraphicsPipelineKey::color_attachments, color_formats);
+            impl->graphics_key.Set(&GraphicsPipelineKey::depth_attachment, impl->depth_attachment_format);
+            impl->graphics_key.Set(&GraphicsPipelineKey::stencil_attachment, impl->stencil_attachment_format);
+            impl->graphics_key.Set(&GraphicsPipelineKey::view_mask, impl->view_mask);
+            impl->graphics_state_dirty = true;
+        }
+
         impl->context->vkCmdBeginRendering(impl->buffer, &vk_info);
     }
 
@@ -4,19 +4,19 @@ namespace nova
 {
     Fence Fence::Create(HContext context)
     {
-        auto impl = new Impl;
-        impl->context = context;
+        auto fence = context->fence_pool.Acquire();
+        fence->context = context;
 
-        vkh::Check(impl->context->vkCreateSemaphore(context->device, PtrTo(VkSemaphoreCreateInfo {
+        vkh::Check(fence->context->vkCreateSemaphore(context->device, PtrTo(VkSemaphoreCreateInfo {
             .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
             .pNext = PtrTo(VkSemaphoreTypeCreateInfo {
                 .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
                 .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
                 .initialValue = 0,
             }),
-        }), context->alloc, &impl->semaphore));
+        }), context->alloc, &fence->semaphore));
 
-        return { impl };
+        return fence;
     }
 
     void Fence::Destroy()
@@ -25,11 +25,13 @@ namespace nova
             return;
         }
 
+        ImplPool<Fence>::Validate(impl, generation);
+
         Wait();
 
         impl->context->vkDestroySemaphore(impl->context->device, impl->semaphore, impl->context->alloc);
 
-        delete impl;
+        impl->context->fence_pool.Release(impl, generation);
         impl = nullptr;
     }
 
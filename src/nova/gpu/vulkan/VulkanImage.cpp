@@ -4,10 +4,10 @@ namespace nova
 {
     Sampler Sampler::Create(HContext context, Filter filter, AddressMode address_mode, BorderColor color, f32 anisotropy)
     {
-        auto impl = new Impl;
-        impl->context = context;
+        auto sampler = context->sampler_pool.Acquire();
+        sampler->context = context;
 
-        vkh::Check(impl->context->vkCreateSampler(context->device, PtrTo(VkSamplerCreateInfo {
+        vkh::Check(sampler->context->vkCreateSampler(context->device, PtrTo(VkSamplerCreateInfo {
             .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
             .magFilter = GetVulkanFilter(filter),
             .minFilter = GetVulkanFilter(filter),
@@ -22,18 +22,15 @@ namespace nova
             .maxAnisotropy = anisotropy,
             .maxLod = VK_LOD_CLAMP_NONE,
             .borderColor = GetVulkanBorderColor(color),
-        }), context->alloc, &impl->sampler));
+        }), context->alloc, &sampler->sampler));
 
-        {
-            std::scoped_lock lock{ context->global_heap.mutex };
-            impl->descriptor_index = context->global_heap.sampler_handles.Acquire();
+        sampler->descriptor = context->global_heap.sampler_handles.Acquire();
 #ifdef RHI_NOISY_ALLOCATIONS
-            Log("Sampler Descriptor Acquired: {}", impl->descriptorIndex);
+        Log("Sampler Descriptor Acquired: {}", sampler->descriptor.index);
 #endif
-        }
-        context->global_heap.WriteSampler(impl->descriptor_index, impl);
+        context->global_heap.WriteSampler(sampler->descriptor.index, sampler);
 
-        return { impl };
+        return sampler;
     }
 
     void Sampler::Destroy()
@@ -42,52 +39,51 @@ namespace nova
             return;
         }
 
+        ImplPool<Sampler>::Validate(impl, generation);
+
         impl->context->vkDestroySampler(impl->context->device, impl->sampler, impl->context->alloc);
 
-        {
-            std::scoped_lock lock{ impl->context->global_heap.mutex };
-            impl->context->global_heap.sampler_handles.Release(impl->descriptor_index);
+        impl->context->global_heap.sampler_handles.Release(impl->descriptor);
 #ifdef RHI_NOISY_ALLOCATIONS
-            Log("Sampler Descriptor Released: {}", impl->descriptorIndex);
+        Log("Sampler Descriptor Released: {}", impl->descriptor.index);
 #endif
-        }
 
-        delete impl;
+        impl->context->sampler_pool.Release(impl, generation);
         impl = nullptr;
     }
 
     SamplerDescriptor Sampler::Descriptor() const
     {
-        return impl->descriptor_index;
+        return impl->descriptor.index;
     }
 
 // -----------------------------------------------------------------------------
 
     Image Image::Create(HContext context, Vec3U size, ImageUsage usage, nova::Format format, ImageFlags flags)
     {
-        auto impl = new Impl;
-        impl->context = context;
-        impl->format = format;
-        impl->usage = usage;
+        auto image = context->image_pool.Acquire();
+        image->context = context;
+        image->format = format;
+        image->usage = usage;
         bool make_view = (GetVulkanImageUsage(usage) & ~(VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT)) != 0;
 
-        impl->mips = flags >= ImageFlags::Mips
+        image->mips = flags >= ImageFlags::Mips
             ? 1 + u32(std::log2(f32(std::max(size.x, size.y))))
             : 1;
 
         VkImageType image_type;
         VkImageViewType view_type;
-        impl->layers = 1;
+        image->layers = 1;
 
         if (flags >= ImageFlags::Array) {
             if (size.z > 0) {
-                impl->layers = size.z;
+                image->layers = size.z;
                 size.z = 1;
                 image_type = VK_IMAGE_TYPE_2D;
                 view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
 
             } else if (size.y > 0) {
-                impl->layers = size.y;
+                image->layers = size.y;
                 size.y = 1;
                 image_type = VK_IMAGE_TYPE_1D;
                 view_type = VK_IMAGE_VIEW_TYPE_1D_ARRAY;
@@ -111,14 +107,14 @@ namespace nova
             }
         }
 
-        impl->extent = glm::max(size, Vec3U(1));
+        image->extent = glm::max(size, Vec3U(1));
 
         // ---- Create image -----
 
         VmaAllocationInfo info;
 
         VkMemoryPropertyFlags vk_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-        auto vk_usage = GetVulkanImageUsage(impl->usage);
+        auto vk_usage = GetVulkanImageUsage(image->usage);
         vk_usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
         if (!context->transfer_manager.staged_image_copy) {
             vk_usage |= VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
@@ -129,10 +125,10 @@ namespace nova
             PtrTo(VkImageCreateInfo {
                 .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
                 .imageType = VK_IMAGE_TYPE_2D,
-                .format = GetVulkanFormat(impl->format).vk_format,
-                .extent = { impl->extent.x, impl->extent.y, impl->extent.z },
-                .mipLevels = impl->mips,
-                .arrayLayers = impl->layers,
+                .format = GetVulkanFormat(image->format).vk_format,
+                .extent = { image->extent.x, image->extent.y, image->extent.z },
+                .mipLevels = image->mips,
+                .arrayLayers = image->layers,
                 .samples = VK_SAMPLE_COUNT_1_BIT,
                 .tiling = VK_IMAGE_TILING_OPTIMAL,
                 .usage = vk_usage,
@@ -145,8 +141,8 @@ namespace nova
                 .usage = VMA_MEMORY_USAGE_AUTO,
                 .requiredFlags = vk_flags,
             }),
-            &impl->image,
-            &impl->allocation,
+            &image->image,
+            &image->allocation,
             &info));
 
         rhi::stats::AllocationCount++;
@@ -155,37 +151,37 @@ namespace nova
 
         // ---- Pick aspects -----
 
-        switch (GetVulkanFormat(impl->format).vk_format) {
+        switch (GetVulkanFormat(image->format).vk_format) {
         break;case VK_FORMAT_S8_UINT:
-            impl->aspect = VK_IMAGE_ASPECT_STENCIL_BIT;
+            image->aspect = VK_IMAGE_ASPECT_STENCIL_BIT;
 
         break;case VK_FORMAT_D16_UNORM:
               case VK_FORMAT_X8_D24_UNORM_PACK32:
               case VK_FORMAT_D32_SFLOAT:
-            impl->aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+            image->aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
 
         break;case VK_FORMAT_D16_UNORM_S8_UINT:
               case VK_FORMAT_D24_UNORM_S8_UINT:
               case VK_FORMAT_D32_SFLOAT_S8_UINT:
-            impl->aspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            image->aspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
 
         break;default:
-            impl->aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+            image->aspect = VK_IMAGE_ASPECT_COLOR_BIT;
         }
 
         // ---- Make view -----
 
         if (make_view) {
-            vkh::Check(impl->context->vkCreateImageView(context->device, PtrTo(VkImageViewCreateInfo {
+            vkh::Check(image->context->vkCreateImageView(context->device, PtrTo(VkImageViewCreateInfo {
                 .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-                .image = impl->image,
+                .image = image->image,
                 .viewType = view_type,
-                .format = GetVulkanFormat(impl->format).vk_format,
-                .subresourceRange = { impl->aspect, 0, impl->mips, 0, impl->layers },
-            }), context->alloc, &impl->view));
+                .format = GetVulkanFormat(image->format).vk_format,
+                .subresourceRange = { image->aspect, 0, image->mips, 0, image->layers },
+            }), context->alloc, &image->view));
         }
 
-        return { impl };
+        return image;
     }
 
     void Image::Destroy()
@@ -194,6 +190,8 @@ namespace nova
             return;
         }
 
+        ImplPool<Image>::Validate(impl, generation);
+
         if (impl->view) {
             impl->context->vkDestroyImageView(impl->context->device, impl->view, impl->context->alloc);
         }
@@ -206,41 +204,34 @@ namespace nova
             vmaDestroyImage(impl->context->vma, impl->image, impl->allocation);
         }
 
-        if (impl->descriptor_index != UINT_MAX) {
-            auto& heap = impl->context->global_heap;
-            std::scoped_lock lock{ heap.mutex };
-            impl->context->global_heap.image_handles.Release(impl->descriptor_index);
+        if (impl->descriptor) {
+            impl->context->global_heap.image_handles.Release(impl->descriptor);
 #ifdef RHI_NOISY_ALLOCATIONS
-            Log("Image Descriptor Released: {} (total = {})",
-                impl->descriptorIndex, heap.imageHandles.nextIndex - heap.imageHandles.freeList.size());
+            Log("Image Descriptor Released: {}", impl->descriptor.index);
 #endif
         }
 
-        delete impl;
+        impl->context->image_pool.Release(impl, generation);
         impl = nullptr;
     }
 
     ImageDescriptor Image::Descriptor() const
     {
-        if (impl->descriptor_index == UINT_MAX) {
+        if (!impl->descriptor) {
             auto& heap = impl->context->global_heap;
-            {
-                std::scoped_lock lock{ heap.mutex };
-                impl->descriptor_index = heap.image_handles.Acquire();
+            impl->descriptor = heap.image_handles.Acquire();
 #ifdef RHI_NOISY_ALLOCATIONS
-                Log("Image Descriptor Acquired: {} (total = {})",
-                    impl->descriptorIndex, heap.imageHandles.nextIndex - heap.imageHandles.freeList.size());
+            Log("Image Descriptor Acquired: {}", impl->descriptor.index);
 #endif
-            }
             if (impl->usage >= nova::ImageUsage::Sampled) {
-                heap.WriteSampled(impl->descriptor_index, *this);
+                heap.WriteSampled(impl->descriptor.index, *this);
             }
             if (impl->usage >= nova::ImageUsage::Storage) {
-                heap.WriteStorage(impl->descriptor_index, *this);
+                heap.WriteStorage(impl->descriptor.index, *this);
             }
         }
 
-        return impl->descriptor_index;
+        return impl->descriptor.index;
     }
 
     Vec3U Image::Extent() const
@@ -36,46 +36,19 @@ namespace nova
 
 // -----------------------------------------------------------------------------
 
+    // Strip and fan topologies only differ in dynamic state, so pipelines are keyed by their topology class
     static
-    GraphicsPipelineKey GetGraphicsPipelineKey(CommandList cmd)
+    Topology GetTopologyClass(Topology topology)
     {
-        GraphicsPipelineKey key;
-
-        // This needs to be explicit zeroed to handle padding bytes
-        std::memset(&key, 0, sizeof(key));
-
-        switch (cmd->topology) {
-            break;case Topology::Points:
-                key.topology = Topology::Points;
-            break;case Topology::Lines:
-                  case Topology::LineStrip:
-                key.topology = Topology::Lines;
-            break;case Topology::Triangles:
-                  case Topology::TriangleStrip:
+        switch (topology) {
+            break;case Topology::LineStrip:
+                return Topology::Lines;
+            break;case Topology::TriangleStrip:
                   case Topology::TriangleFan:
-                key.topology = Topology::Triangles;
-            break;case Topology::Patches:
-                key.topology = Topology::Patches;
+                return Topology::Triangles;
+            break;default:
+                return topology;
         }
-
-        key.poly_mode = cmd->polygon_mode;
-
-        for (u32 i = 0; i < cmd->shaders.size(); ++i) {
-            key.shaders[i] = cmd->shaders[i]->id;
-        }
-
-        std::memcpy(
-            key.color_attachments.data(),
-            cmd->color_attachments_formats.data(),
-            cmd->color_attachments_formats.size() * sizeof(VkFormat));
-        key.depth_attachment = cmd->depth_attachment_format;
-        key.stencil_attachment = cmd->stencil_attachment_format;
-
-        key.blend_states = cmd->blend_states;
-
-        key.view_mask = cmd->view_mask;
-
-        return key;
     }
 
 // -----------------------------------------------------------------------------
@@ -83,113 +56,111 @@ namespace nova
 // -----------------------------------------------------------------------------
 
     static
-    VkPipeline GetGraphicsMonolithPipeline(nova::CommandList cmd, const GraphicsPipelineKey& key)
+    VkPipeline GetGraphicsMonolithPipeline(nova::CommandList cmd, const HashedKey<GraphicsPipelineKey>& key)
     {
         NOVA_STACK_POINT();
 
         auto context = cmd->context;
-        auto pipeline = context->graphics_pipeline_sets[key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->graphics_pipeline_sets.GetOrCreate(key, [&] {
+            VkPipeline pipeline;
 
-        // Creating monolothic pipeline
+            // Creating monolothic pipeline
 
-        auto start = std::chrono::steady_clock::now();
+            auto start = std::chrono::steady_clock::now();
 
-        auto stages = NOVA_STACK_ALLOC(VkPipelineShaderStageCreateInfo, cmd->shaders.size());
-        for (u32 i = 0; i < cmd->shaders.size(); ++i) {
-            stages[i] = cmd->shaders[i]->GetStageInfo();
-        }
+            auto stages = NOVA_STACK_ALLOC(VkPipelineShaderStageCreateInfo, cmd->shaders.size());
+            for (u32 i = 0; i < cmd->shaders.size(); ++i) {
+                stages[i] = cmd->shaders[i]->GetStageInfo();
+            }
 
-        // Blend states
-        // TODO: Deduplicate
+            // Blend states
+            // TODO: Deduplicate
 
-        auto* attach_blend_states = NOVA_STACK_ALLOC(VkPipelineColorBlendAttachmentState, cmd->color_attachments_formats.size());
+            auto* attach_blend_states = NOVA_STACK_ALLOC(VkPipelineColorBlendAttachmentState, cmd->color_attachments_formats.size());
 
-        for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
-            auto& attach_state = attach_blend_states[i];
-            attach_state = {};
+            for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
+                auto& attach_state = attach_blend_states[i];
+                attach_state = {};
 
-            attach_state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-                | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-            attach_state.blendEnable = cmd->blend_states[i];
-
-            if (cmd->blend_states[i]) {
-                attach_state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-                attach_state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-                attach_state.colorBlendOp = VK_BLEND_OP_ADD;
-                attach_state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-                attach_state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-                attach_state.alphaBlendOp = VK_BLEND_OP_ADD;
+                attach_state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+                    | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+                attach_state.blendEnable = cmd->blend_states[i];
+
+                if (cmd->blend_states[i]) {
+                    attach_state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                    attach_state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                    attach_state.colorBlendOp = VK_BLEND_OP_ADD;
+                    attach_state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                    attach_state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                    attach_state.alphaBlendOp = VK_BLEND_OP_ADD;
+                }
             }
-        }
 
-        // Rendering info - formats
+            // Rendering info - formats
 
-        auto vk_formats = NOVA_STACK_ALLOC(VkFormat, cmd->color_attachments_formats.size());
-        for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
-            vk_formats[i] = GetVulkanFormat(cmd->color_attachments_formats[i]).vk_format;
-        }
+            auto vk_formats = NOVA_STACK_ALLOC(VkFormat, cmd->color_attachments_formats.size());
+            for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
+                vk_formats[i] = GetVulkanFormat(cmd->color_attachments_formats[i]).vk_format;
+            }
 
-        vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkPipelineRenderingCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
-                    .viewMask = cmd->view_mask,
-                    .colorAttachmentCount = u32(cmd->color_attachments_formats.size()),
-                    .pColorAttachmentFormats = vk_formats,
-                    .depthAttachmentFormat = GetVulkanFormat(cmd->depth_attachment_format).vk_format,
-                    .stencilAttachmentFormat = GetVulkanFormat(cmd->stencil_attachment_format).vk_format,
-                }),
-                .flags = context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0),
-                .stageCount = u32(cmd->shaders.size()),
-                .pStages = stages,
-                .pVertexInputState = PtrTo(VkPipelineVertexInputStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-                }),
-                .pInputAssemblyState = PtrTo(VkPipelineInputAssemblyStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-                    .topology = GetVulkanTopology(key.topology),
-                }),
-                .pViewportState = PtrTo(VkPipelineViewportStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-                }),
-                .pRasterizationState = PtrTo(VkPipelineRasterizationStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-                    .polygonMode = GetVulkanPolygonMode(cmd->polygon_mode),
-                }),
-                .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-                }),
-                .pColorBlendState = PtrTo(VkPipelineColorBlendStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-                    .logicOpEnable = VK_FALSE,
-                    .logicOp = VK_LOGIC_OP_COPY,
-                    .attachmentCount = u32(cmd->color_attachments_formats.size()),
-                    .pAttachments = attach_blend_states,
-                }),
-                .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                    .dynamicStateCount = u32(DynamicStates.size()),
-                    .pDynamicStates = DynamicStates.data(),
-                }),
-                .layout = context->global_heap.pipeline_layout,
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Compiled new graphics pipeline in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+            vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkPipelineRenderingCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                        .viewMask = cmd->view_mask,
+                        .colorAttachmentCount = u32(cmd->color_attachments_formats.size()),
+                        .pColorAttachmentFormats = vk_formats,
+                        .depthAttachmentFormat = GetVulkanFormat(cmd->depth_attachment_format).vk_format,
+                        .stencilAttachmentFormat = GetVulkanFormat(cmd->stencil_attachment_format).vk_format,
+                    }),
+                    .flags = context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0),
+                    .stageCount = u32(cmd->shaders.size()),
+                    .pStages = stages,
+                    .pVertexInputState = PtrTo(VkPipelineVertexInputStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                    }),
+                    .pInputAssemblyState = PtrTo(VkPipelineInputAssemblyStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+                        .topology = GetVulkanTopology(key->topology),
+                    }),
+                    .pViewportState = PtrTo(VkPipelineViewportStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                    }),
+                    .pRasterizationState = PtrTo(VkPipelineRasterizationStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+                        .polygonMode = GetVulkanPolygonMode(cmd->polygon_mode),
+                    }),
+                    .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+                    }),
+                    .pColorBlendState = PtrTo(VkPipelineColorBlendStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                        .logicOpEnable = VK_FALSE,
+                        .logicOp = VK_LOGIC_OP_COPY,
+                        .attachmentCount = u32(cmd->color_attachments_formats.size()),
+                        .pAttachments = attach_blend_states,
+                    }),
+                    .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                        .dynamicStateCount = u32(DynamicStates.size()),
+                        .pDynamicStates = DynamicStates.data(),
+                    }),
+                    .layout = context->global_heap.pipeline_layout,
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
+
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Compiled new graphics pipeline in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
 
-        context->graphics_pipeline_sets[key] = pipeline;
-        return pipeline;
+            return pipeline;
+        });
     }
 
 // -----------------------------------------------------------------------------
@@ -207,58 +178,56 @@ namespace nova
         std::memset(&stage_key, 0, sizeof(stage_key));
         stage_key.topology = key.topology;
 
-        auto pipeline = context->vertex_input_stages[stage_key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->vertex_input_stages.GetOrCreate(stage_key, [&] {
+            VkPipeline pipeline;
 
-        // Creating vertex input pipeline stage
+            // Creating vertex input pipeline stage
 
-        auto start = std::chrono::steady_clock::now();
-        vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
-                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
-                    .pNext = PtrTo(VkPipelineRenderingCreateInfo {
-                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+            auto start = std::chrono::steady_clock::now();
+            vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
+                        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+                        .pNext = PtrTo(VkPipelineRenderingCreateInfo {
+                            .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                        }),
+                        .flags = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
                     }),
-                    .flags = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
-                }),
-                .flags = (context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0))
-                    | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
-                .pVertexInputState = PtrTo(VkPipelineVertexInputStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-                }),
-                .pInputAssemblyState = PtrTo(VkPipelineInputAssemblyStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-                    .topology = GetVulkanTopology(key.topology),
-                }),
-                .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-                }),
-                .pDepthStencilState = PtrTo(VkPipelineDepthStencilStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
-                }),
-                .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                    .dynamicStateCount = u32(DynamicStates.size()),
-                    .pDynamicStates = DynamicStates.data(),
-                }),
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Compiled new graphics vertex input    stage permutation in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+                    .flags = (context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0))
+                        | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
+                    .pVertexInputState = PtrTo(VkPipelineVertexInputStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                    }),
+                    .pInputAssemblyState = PtrTo(VkPipelineInputAssemblyStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+                        .topology = GetVulkanTopology(key.topology),
+                    }),
+                    .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+                    }),
+                    .pDepthStencilState = PtrTo(VkPipelineDepthStencilStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+                    }),
+                    .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                        .dynamicStateCount = u32(DynamicStates.size()),
+                        .pDynamicStates = DynamicStates.data(),
+                    }),
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
 
-        context->vertex_input_stages[stage_key] = pipeline;
-        return pipeline;
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Compiled new graphics vertex input    stage permutation in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
+
+            return pipeline;
+        });
     }
 
     static
@@ -278,59 +247,57 @@ namespace nova
             stage_key.shaders[i] = shaders[i]->id;
         }
 
-        auto pipeline = context->preraster_stages[stage_key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->preraster_stages.GetOrCreate(stage_key, [&] {
+            VkPipeline pipeline;
 
-        // Creating pre rasterization pipeline stage
+            // Creating pre rasterization pipeline stage
 
-        auto stages = NOVA_STACK_ALLOC(VkPipelineShaderStageCreateInfo, shaders.size());
-        for (u32 i = 0; i < shaders.size(); ++i) {
-            stages[i] = shaders[i]->GetStageInfo();
-        }
+            auto stages = NOVA_STACK_ALLOC(VkPipelineShaderStageCreateInfo, shaders.size());
+            for (u32 i = 0; i < shaders.size(); ++i) {
+                stages[i] = shaders[i]->GetStageInfo();
+            }
 
-        auto start = std::chrono::steady_clock::now();
-        vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkPipelineRenderingCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
-                    .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
-                        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
-                        .flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+            auto start = std::chrono::steady_clock::now();
+            vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkPipelineRenderingCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                        .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
+                            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+                            .flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                        }),
                     }),
-                }),
-                .flags = (context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0))
-                    | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
-                .stageCount = u32(shaders.size()),
-                .pStages = stages,
-                .pViewportState = PtrTo(VkPipelineViewportStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-                }),
-                .pRasterizationState = PtrTo(VkPipelineRasterizationStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-                    .polygonMode = GetVulkanPolygonMode(cmd->polygon_mode),
-                }),
-                .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                    .dynamicStateCount = u32(DynamicStates.size()),
-                    .pDynamicStates = DynamicStates.data(),
-                }),
-                .layout = context->global_heap.pipeline_layout,
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Compiled new graphics pre-raster      stage permutation in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+                    .flags = (context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0))
+                        | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
+                    .stageCount = u32(shaders.size()),
+                    .pStages = stages,
+                    .pViewportState = PtrTo(VkPipelineViewportStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                    }),
+                    .pRasterizationState = PtrTo(VkPipelineRasterizationStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+                        .polygonMode = GetVulkanPolygonMode(cmd->polygon_mode),
+                    }),
+                    .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                        .dynamicStateCount = u32(DynamicStates.size()),
+                        .pDynamicStates = DynamicStates.data(),
+                    }),
+                    .layout = context->global_heap.pipeline_layout,
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
+
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Compiled new graphics pre-raster      stage permutation in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
 
-        context->preraster_stages[stage_key] = pipeline;
-        return pipeline;
+            return pipeline;
+        });
     }
 
     static
@@ -345,54 +312,52 @@ namespace nova
         stage_key.shader = shader->id;
         stage_key.view_mask = key.view_mask;
 
-        auto pipeline = context->fragment_shader_stages[stage_key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->fragment_shader_stages.GetOrCreate(stage_key, [&] {
+            VkPipeline pipeline;
 
-        // Creating fragment shader pipeline stage
+            // Creating fragment shader pipeline stage
 
-        auto start = std::chrono::steady_clock::now();
-        vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkPipelineRenderingCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
-                    .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
-                        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
-                        .flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+            auto start = std::chrono::steady_clock::now();
+            vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkPipelineRenderingCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                        .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
+                            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+                            .flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+                        }),
                     }),
-                }),
-                .flags = (context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0))
-                    | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
-                .stageCount = 1,
-                .pStages = PtrTo(shader->GetStageInfo()),
-                .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-                }),
-                .pDepthStencilState = PtrTo(VkPipelineDepthStencilStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
-                }),
-                .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                    .dynamicStateCount = u32(DynamicStates.size()),
-                    .pDynamicStates = DynamicStates.data(),
-                }),
-                .layout = context->global_heap.pipeline_layout,
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Compiled new graphics fragment shader stage permutation in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+                    .flags = (context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0))
+                        | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
+                    .stageCount = 1,
+                    .pStages = PtrTo(shader->GetStageInfo()),
+                    .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+                    }),
+                    .pDepthStencilState = PtrTo(VkPipelineDepthStencilStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+                    }),
+                    .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                        .dynamicStateCount = u32(DynamicStates.size()),
+                        .pDynamicStates = DynamicStates.data(),
+                    }),
+                    .layout = context->global_heap.pipeline_layout,
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
+
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Compiled new graphics fragment shader stage permutation in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
 
-        context->fragment_shader_stages[stage_key] = pipeline;
-        return pipeline;
+            return pipeline;
+        });
     }
 
     static
@@ -412,145 +377,141 @@ namespace nova
         stage_key.stencil_attachment = key.stencil_attachment;
         stage_key.view_mask = key.view_mask;
 
-        auto pipeline = context->fragment_output_stages[stage_key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->fragment_output_stages.GetOrCreate(stage_key, [&] {
+            VkPipeline pipeline;
 
-        // Creating fragment output pipeline stage
+            // Creating fragment output pipeline stage
 
-        // Blend states
-        // TODO: Deduplicate
+            // Blend states
+            // TODO: Deduplicate
 
-        auto* attach_blend_states = NOVA_STACK_ALLOC(VkPipelineColorBlendAttachmentState, cmd->color_attachments_formats.size());
+            auto* attach_blend_states = NOVA_STACK_ALLOC(VkPipelineColorBlendAttachmentState, cmd->color_attachments_formats.size());
 
-        for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
-            auto& attach_state = attach_blend_states[i];
-            attach_state = {};
+            for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
+                auto& attach_state = attach_blend_states[i];
+                attach_state = {};
 
-            attach_state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-                | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-            attach_state.blendEnable = cmd->blend_states[i];
-
-            if (cmd->blend_states[i]) {
-                attach_state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-                attach_state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-                attach_state.colorBlendOp = VK_BLEND_OP_ADD;
-                attach_state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-                attach_state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-                attach_state.alphaBlendOp = VK_BLEND_OP_ADD;
+                attach_state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+                    | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+                attach_state.blendEnable = cmd->blend_states[i];
+
+                if (cmd->blend_states[i]) {
+                    attach_state.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                    attach_state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                    attach_state.colorBlendOp = VK_BLEND_OP_ADD;
+                    attach_state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                    attach_state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                    attach_state.alphaBlendOp = VK_BLEND_OP_ADD;
+                }
             }
-        }
 
-        auto vk_formats = NOVA_STACK_ALLOC(VkFormat, cmd->color_attachments_formats.size());
-        for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
-            vk_formats[i] = GetVulkanFormat(cmd->color_attachments_formats[i]).vk_format;
-        }
+            auto vk_formats = NOVA_STACK_ALLOC(VkFormat, cmd->color_attachments_formats.size());
+            for (u32 i = 0; i < cmd->color_attachments_formats.size(); ++i) {
+                vk_formats[i] = GetVulkanFormat(cmd->color_attachments_formats[i]).vk_format;
+            }
 
-        auto start = std::chrono::steady_clock::now();
-        vkh::Check(cmd->context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkPipelineRenderingCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
-                    .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
-                        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
-                        .flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+            auto start = std::chrono::steady_clock::now();
+            vkh::Check(cmd->context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkPipelineRenderingCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                        .pNext = PtrTo(VkGraphicsPipelineLibraryCreateInfoEXT {
+                            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+                            .flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                        }),
+                        .colorAttachmentCount = u32(cmd->color_attachments_formats.size()),
+                        .pColorAttachmentFormats = vk_formats,
+                        .depthAttachmentFormat = GetVulkanFormat(cmd->depth_attachment_format).vk_format,
+                        .stencilAttachmentFormat = GetVulkanFormat(cmd->stencil_attachment_format).vk_format,
                     }),
-                    .colorAttachmentCount = u32(cmd->color_attachments_formats.size()),
-                    .pColorAttachmentFormats = vk_formats,
-                    .depthAttachmentFormat = GetVulkanFormat(cmd->depth_attachment_format).vk_format,
-                    .stencilAttachmentFormat = GetVulkanFormat(cmd->stencil_attachment_format).vk_format,
-                }),
-                .flags = (context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0))
-                    | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
-                .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-                    .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-                }),
-                .pColorBlendState = PtrTo(VkPipelineColorBlendStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-                    .logicOpEnable = VK_FALSE,
-                    .logicOp = VK_LOGIC_OP_COPY,
-                    .attachmentCount = u32(cmd->color_attachments_formats.size()),
-                    .pAttachments = attach_blend_states,
-                }),
-                .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                    .dynamicStateCount = u32(DynamicStates.size()),
-                    .pDynamicStates = DynamicStates.data(),
-                }),
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Compiled new graphics fragment output stage permutation in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+                    .flags = (context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0))
+                        | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR,
+                    .pMultisampleState = PtrTo(VkPipelineMultisampleStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+                    }),
+                    .pColorBlendState = PtrTo(VkPipelineColorBlendStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                        .logicOpEnable = VK_FALSE,
+                        .logicOp = VK_LOGIC_OP_COPY,
+                        .attachmentCount = u32(cmd->color_attachments_formats.size()),
+                        .pAttachments = attach_blend_states,
+                    }),
+                    .pDynamicState = PtrTo(VkPipelineDynamicStateCreateInfo {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                        .dynamicStateCount = u32(DynamicStates.size()),
+                        .pDynamicStates = DynamicStates.data(),
+                    }),
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
+
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Compiled new graphics fragment output stage permutation in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
 
-        context->fragment_output_stages[stage_key] = pipeline;
-        return pipeline;
+            return pipeline;
+        });
     }
 
     static
-    VkPipeline GetGraphicsPipelineLibrarySet(CommandList cmd, const GraphicsPipelineKey& key)
+    VkPipeline GetGraphicsPipelineLibrarySet(CommandList cmd, const HashedKey<GraphicsPipelineKey>& key)
     {
         auto context = cmd->context;
-        auto pipeline = context->graphics_pipeline_sets[key];
-        if (pipeline) {
-            return pipeline;
-        }
+        return context->graphics_pipeline_sets.GetOrCreate(key, [&] {
+            VkPipeline pipeline;
+
+            // Separate preraster/fragment shaders
+
+            Shader fragment_shader = {};
+            std::array<Shader, 4> preraster_stage_shaders;
+            u32 preraster_stage_shader_index = 0;
+            for (auto& shader : cmd->shaders) {
+                if (shader->stage == ShaderStage::Fragment) {
+                    fragment_shader = shader;
+                } else {
+                    preraster_stage_shaders[preraster_stage_shader_index++] = shader;
+                }
+            }
 
-        // Separate preraster/fragment shaders
+            // Get stages
 
-        Shader fragment_shader = {};
-        std::array<Shader, 4> preraster_stage_shaders;
-        u32 preraster_stage_shader_index = 0;
-        for (auto& shader : cmd->shaders) {
-            if (shader->stage == ShaderStage::Fragment) {
-                fragment_shader = shader;
-            } else {
-                preraster_stage_shaders[preraster_stage_shader_index++] = shader;
-            }
-        }
+            std::array<VkPipeline, 4> stages;
+            stages[0] = GetGraphicsVertexInputStage(cmd, key.Get());
+            stages[1] = GetGraphicsPreRasterizationStage(cmd, key.Get(), { preraster_stage_shaders.data(), preraster_stage_shader_index });
+            stages[2] = GetGraphicsFragmentShaderStage(cmd, key.Get(), fragment_shader);
+            stages[3] = GetGraphicsFragmentOutputStage(cmd, key.Get());
 
-        // Get stages
-
-        std::array<VkPipeline, 4> stages;
-        stages[0] = GetGraphicsVertexInputStage(cmd, key);
-        stages[1] = GetGraphicsPreRasterizationStage(cmd, key, { preraster_stage_shaders.data(), preraster_stage_shader_index });
-        stages[2] = GetGraphicsFragmentShaderStage(cmd, key, fragment_shader);
-        stages[3] = GetGraphicsFragmentOutputStage(cmd, key);
-
-        // Link library
-
-        auto start = std::chrono::steady_clock::now();
-        vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
-            1, PtrTo(VkGraphicsPipelineCreateInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = PtrTo(VkPipelineLibraryCreateInfoKHR {
-                    .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
-                    .libraryCount = 4,
-                    .pLibraries = stages.data(),
-                }),
-                .flags = context->descriptor_buffers
-                        ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                        : VkPipelineCreateFlags(0),
-                .layout = context->global_heap.pipeline_layout,
-                .basePipelineIndex = -1,
-            }), context->alloc, &pipeline));
-
-        auto dur = std::chrono::steady_clock::now() - start;
-        if (context->config.trace) {
-            Log("Linked new graphics library set permutation in {}",
-                std::chrono::duration_cast<std::chrono::microseconds>(dur));
-        }
+            // Link library
 
-        context->graphics_pipeline_sets[key] = pipeline;
-        return pipeline;
+            auto start = std::chrono::steady_clock::now();
+            vkh::Check(context->vkCreateGraphicsPipelines(context->device, context->pipeline_cache,
+                1, PtrTo(VkGraphicsPipelineCreateInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = PtrTo(VkPipelineLibraryCreateInfoKHR {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+                        .libraryCount = 4,
+                        .pLibraries = stages.data(),
+                    }),
+                    .flags = context->descriptor_buffers
+                            ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                            : VkPipelineCreateFlags(0),
+                    .layout = context->global_heap.pipeline_layout,
+                    .basePipelineIndex = -1,
+                }), context->alloc, &pipeline));
+
+            auto dur = std::chrono::steady_clock::now() - start;
+            if (context->config.trace) {
+                Log("Linked new graphics library set permutation in {}",
+                    std::chrono::duration_cast<std::chrono::microseconds>(dur));
+            }
+
+            return pipeline;
+        });
     }
 
 // -----------------------------------------------------------------------------
@@ -561,14 +522,13 @@ namespace nova
             return;
         }
 
-        graphics_state_dirty = false;
+        NOVA_PROFILE_SCOPE("CommandList::EnsureGraphicsState");
 
-        std::scoped_lock lock{ context->pipeline_cache_mutex };
+        graphics_state_dirty = false;
 
-        auto key = GetGraphicsPipelineKey({this});
         auto pipeline = context->graphics_pipeline_library
-            ? GetGraphicsPipelineLibrarySet({this}, key)
-            : GetGraphicsMonolithPipeline({this}, key);
+            ? GetGraphicsPipelineLibrarySet({this}, graphics_key)
+            : GetGraphicsMonolithPipeline({this}, graphics_key);
 
         if (pipeline != bound_graphics_pipeline) {
             context->vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
@@ -659,6 +619,8 @@ namespace nova
         } else {
             impl->topology = topology;
             impl->polygon_mode = polygon_mode;
+            impl->graphics_key.Set(&GraphicsPipelineKey::topology, GetTopologyClass(topology));
+            impl->graphics_key.Set(&GraphicsPipelineKey::poly_mode, polygon_mode);
             impl->graphics_state_dirty = true;
         }
         impl->context->vkCmdSetLineWidth(impl->buffer, line_width);
@@ -687,6 +649,7 @@ namespace nova
             for (u32 i = 0; i < blends.size(); ++i) {
                 impl->blend_states.set(i, blends[i]);
             }
+            impl->graphics_key.Set(&GraphicsPipelineKey::blend_states, impl->blend_states);
             impl->graphics_state_dirty = true;
 
             return;
@@ -746,8 +709,8 @@ namespace nova
 
                 auto context = impl->context;
 
-                auto pipeline = context->compute_pipelines[key];
-                if (!pipeline) {
+                auto pipeline = context->compute_pipelines.GetOrCreate(key, [&] {
+                    VkPipeline pipeline;
                     vkh::Check(impl->context->vkCreateComputePipelines(context->device, context->pipeline_cache, 1, PtrTo(VkComputePipelineCreateInfo {
                         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
                         .flags = context->descriptor_buffers
@@ -757,9 +720,8 @@ namespace nova
                         .layout = context->global_heap.pipeline_layout,
                         .basePipelineIndex = -1,
                     }), context->alloc, &pipeline));
-
-                    context->compute_pipelines[key] = pipeline;
-                }
+                    return pipeline;
+                });
 
                 impl->context->vkCmdBindPipeline(impl->buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
             } else {
@@ -767,6 +729,12 @@ namespace nova
                 // Graphics
 
                 impl->shaders.assign(shaders.begin(), shaders.end());
+
+                std::array<UID, 5> shader_ids = {};
+                for (u32 i = 0; i < shaders.size(); ++i) {
+                    shader_ids[i] = shaders[i]->id;
+                }
+                impl->graphics_key.Set(&GraphicsPipelineKey::shaders, shader_ids);
                 impl->graphics_state_dirty = true;
             }
 
@@ -24,6 +24,7 @@ namespace nova
 
     SyncPoint Queue::Submit(Span<HCommandList> command_lists, Span<SyncPoint> waits) const
     {
+        NOVA_PROFILE_SCOPE("Queue::Submit");
         NOVA_STACK_POINT();
 
         auto buffer_infos = NOVA_STACK_ALLOC(VkCommandBufferSubmitInfo, command_lists.size());
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <nova/gpu/RHI.hpp>
+#include <nova/core/ConcurrentHashMap.hpp>
+#include <nova/core/Profile.hpp>
+#include <nova/core/SlotMap.hpp>
+#include <nova/core/VirtualVector.hpp>
 
 #ifndef VK_NO_PROTOTYPES
 #  define VK_NO_PROTOTYPES
@@ -81,8 +85,8 @@ namespace nova
             std::vector<CommandList> available_command_lists;
         };
 
-        std::vector<CommandPool*>                        pools;
-        std::deque<SubmittedCommandList> pending_command_lists;
+        std::vector<CommandPool*>                                pools;
+        VirtualVector<SubmittedCommandList> pending_command_lists;
 
         CommandPool* AcquireCommandPool();
         void DestroyCommandPools();
@@ -100,6 +104,23 @@ namespace nova
         std::atomic<u64>      last_seen_value = 0;
     };
 
+    // Color attachment formats are stored inline in pipeline keys, BeginRendering rejects more than this
+    inline constexpr u32 MaxColorAttachments = 8;
+
+    // Graphics pipeline state not covered by dynamic state. Command lists keep it as a HashedKey that setters update
+    // member by member, so flushing dirty state neither rebuilds nor rehashes the whole key
+    struct GraphicsPipelineKey
+    {
+        std::array<UID, 5>                                shaders;
+        Topology                                         topology;
+        PolygonMode                                     poly_mode;
+        std::array<Format, MaxColorAttachments> color_attachments;
+        Format                                   depth_attachment;
+        Format                                 stencil_attachment;
+        u32                                             view_mask;
+        std::bitset<MaxColorAttachments>             blend_states;
+    };
+
     template<>
     struct Handle<CommandList>::Impl
     {
@@ -124,6 +145,8 @@ namespace nova
         std::bitset<8>  blend_states;
         std::vector<HShader> shaders;
 
+        HashedKey<GraphicsPipelineKey> graphics_key;
+
         VkPipeline bound_graphics_pipeline = nullptr;
 
         bool using_shader_objects = false;
@@ -152,10 +175,8 @@ namespace nova
         u64 storage_offset, storage_stride;
         u64 sampler_offset, sampler_stride;
 
-        IndexFreeList   image_handles;
-        IndexFreeList sampler_handles;
-
-        std::shared_mutex mutex;
+        ConcurrentIndexFreeList   image_handles;
+        ConcurrentIndexFreeList sampler_handles;
 
         void Init(HContext context, u32 image_descriptor_count, u32 sampler_descriptor_count);
         void Destroy();
@@ -249,7 +270,7 @@ namespace nova
 
         VkSampler sampler;
 
-        u32 descriptor_index;
+        SlotKey descriptor = {};
     };
 
     template<>
@@ -267,7 +288,7 @@ namespace nova
         VkImageLayout        layout = VK_IMAGE_LAYOUT_UNDEFINED;
         VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_NONE;
 
-        u32 descriptor_index = UINT_MAX;
+        SlotKey descriptor = {};
 
         Vec3U extent = {};
         u32     mips = 0;
@@ -330,20 +351,6 @@ namespace nova
 
     // -----------------------------------------------------------------------------
 
-    struct GraphicsPipelineKey
-    {
-        std::array<UID, 5>              shaders;
-        Topology                       topology;
-        PolygonMode                   poly_mode;
-        std::array<Format, 8> color_attachments;
-        Format                 depth_attachment;
-        Format               stencil_attachment;
-        u32                           view_mask;
-        std::bitset<8>             blend_states;
-
-        NOVA_MEMORY_EQUALITY_MEMBER(GraphicsPipelineKey)
-    };
-
     struct GraphicsPipelineVertexInputStageKey
     {
         Topology topology;
@@ -370,11 +377,11 @@ namespace nova
 
     struct GraphicsPipelineFragmentOutputStageKey
     {
-        std::array<Format, 8> color_attachments;
-        Format                 depth_attachment;
-        Format               stencil_attachment;
-        u32                           view_mask;
-        std::bitset<8>             blend_states;
+        std::array<Format, MaxColorAttachments> color_attachments;
+        Format                                   depth_attachment;
+        Format                                 stencil_attachment;
+        u32                                             view_mask;
+        std::bitset<MaxColorAttachments>             blend_states;
 
         NOVA_MEMORY_EQUALITY_MEMBER(GraphicsPipelineFragmentOutputStageKey)
     };
@@ -387,7 +394,6 @@ namespace nova
     };
 }
 
-NOVA_MEMORY_HASH(nova::GraphicsPipelineKey);
 NOVA_MEMORY_HASH(nova::GraphicsPipelineVertexInputStageKey);
 NOVA_MEMORY_HASH(nova::GraphicsPipelinePreRasterizationStageKey);
 NOVA_MEMORY_HASH(nova::GraphicsPipelineFragmentShaderStageKey);
@@ -436,6 +442,45 @@ namespace nova
     void  Vulkan_NotifyAllocation( void* userdata,                 size_t size, VkInternalAllocationType, VkSystemAllocationScope);
     void  Vulkan_NotifyFree(       void* userdata,                 size_t size, VkInternalAllocationType, VkSystemAllocationScope);
 
+// -----------------------------------------------------------------------------
+//                               Object Pools
+// -----------------------------------------------------------------------------
+
+    // Backing storage for RHI objects owned by a context. Handles point directly at their Impl, which stays put
+    // for its whole lifetime, and carry the generation of its slot. Destroy validates that generation before
+    // releasing anything, so destroying an object twice throws even if its slot has been reused in the meantime
+
+    template<typename H>
+    struct ImplPool
+    {
+        using Impl = typename Handle<H>::Impl;
+
+        std::mutex    mutex;
+        SlotMap<Impl> slots;
+
+        H Acquire()
+        {
+            std::scoped_lock lock{ mutex };
+            auto key = slots.Insert();
+            return H{ { &slots[key], key.generation } };
+        }
+
+        // Called before the Impl is touched, as the Impl of a stale handle has already been destroyed. Only the slot
+        // header is read, slot pages live until the owning context is destroyed. Release re-checks under the lock
+        static void Validate(const Impl* impl, u32 generation)
+        {
+            if (SlotMap<Impl>::KeyOf(impl).generation != generation) {
+                NOVA_THROW("Stale {} handle, object was already destroyed", typeid(H).name());
+            }
+        }
+
+        void Release(const Impl* impl, u32 generation)
+        {
+            std::scoped_lock lock{ mutex };
+            slots.Erase({ slots.KeyOf(impl).index, generation });
+        }
+    };
+
 // -----------------------------------------------------------------------------
 //                                 Context
 // -----------------------------------------------------------------------------
@@ -463,6 +508,15 @@ namespace nova
         DescriptorHeap       global_heap;
         TransferManager transfer_manager;
 
+        ImplPool<Fence>                                                fence_pool;
+        ImplPool<Buffer>                                              buffer_pool;
+        ImplPool<Image>                                                image_pool;
+        ImplPool<Sampler>                                            sampler_pool;
+        ImplPool<Shader>                                              shader_pool;
+        ImplPool<AccelerationStructure>                      accel_structure_pool;
+        ImplPool<AccelerationStructureBuilder>       accel_structure_builder_pool;
+        ImplPool<RayTracingPipeline>                    ray_tracing_pipeline_pool;
+
         std::vector<Queue> graphics_queues = {};
         std::vector<Queue> transfer_queues = {};
         std::vector<Queue>  compute_queues = {};
@@ -514,14 +568,12 @@ namespace nova
         std::atomic_uint64_t next_uid = 1;
         UID GetUID() noexcept { return UID(next_uid++); };
 
-        std::shared_mutex pipeline_cache_mutex;
-
-        HashMap<GraphicsPipelineVertexInputStageKey, VkPipeline>       vertex_input_stages;
-        HashMap<GraphicsPipelinePreRasterizationStageKey, VkPipeline>     preraster_stages;
-        HashMap<GraphicsPipelineFragmentShaderStageKey, VkPipeline> fragment_shader_stages;
-        HashMap<GraphicsPipelineFragmentOutputStageKey, VkPipeline> fragment_output_stages;
-        HashMap<GraphicsPipelineKey, VkPipeline>                    graphics_pipeline_sets;
-        HashMap<ComputePipelineKey, VkPipeline>                          compute_pipelines;
+        ConcurrentHashMap<GraphicsPipelineVertexInputStageKey, VkPipeline>       vertex_input_stages;
+        ConcurrentHashMap<GraphicsPipelinePreRasterizationStageKey, VkPipeline>     preraster_stages;
+        ConcurrentHashMap<GraphicsPipelineFragmentShaderStageKey, VkPipeline> fragment_shader_stages;
+        ConcurrentHashMap<GraphicsPipelineFragmentOutputStageKey, VkPipeline> fragment_output_stages;
+        ConcurrentHashMap<HashedKey<GraphicsPipelineKey>, VkPipeline>         graphics_pipeline_sets;
+        ConcurrentHashMap<ComputePipelineKey, VkPipeline>                          compute_pipelines;
         VkPipelineCache pipeline_cache = {};
 
 // -----------------------------------------------------------------------------
@@ -4,18 +4,18 @@ namespace nova
 {
     RayTracingPipeline RayTracingPipeline::Create(HContext context)
     {
-        auto impl = new Impl;
-        impl->context = context;
+        auto pipeline = context->ray_tracing_pipeline_pool.Acquire();
+        pipeline->context = context;
 
-        impl->sbt_buffer = nova::Buffer::Create(context, 0,
+        pipeline->sbt_buffer = nova::Buffer::Create(context, 0,
             BufferUsage::ShaderBindingTable,
             BufferFlags::DeviceLocal | BufferFlags::Mapped);
 
-        impl->handle_size = impl->context->ray_tracing_pipeline_properties.shaderGroupHandleSize;
-        impl->handle_stride = u32(AlignUpPower2(impl->handle_size,
-            impl->context->ray_tracing_pipeline_properties.shaderGroupHandleAlignment));
+        pipeline->handle_size = pipeline->context->ray_tracing_pipeline_properties.shaderGroupHandleSize;
+        pipeline->handle_stride = u32(AlignUpPower2(pipeline->handle_size,
+            pipeline->context->ray_tracing_pipeline_properties.shaderGroupHandleAlignment));
 
-        return { impl };
+        return pipeline;
     }
 
     void RayTracingPipeline::Destroy()
@@ -24,10 +24,12 @@ namespace nova
             return;
         }
 
+        ImplPool<RayTracingPipeline>::Validate(impl, generation);
+
         impl->sbt_buffer.Destroy();
         impl->context->vkDestroyPipeline(impl->context->device, impl->pipeline, impl->context->alloc);
 
-        delete impl;
+        impl->context->ray_tracing_pipeline_pool.Release(impl, generation);
         impl = nullptr;
     }
 
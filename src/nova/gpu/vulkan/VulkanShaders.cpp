@@ -33,9 +33,11 @@ namespace nova
 
     Shader Shader::Create(HContext context, ShaderLang lang, ShaderStage stage, std::string entry, StringView filename, Span<StringView> fragments)
     {
-        auto impl = new Impl;
-        impl->context = context;
-        impl->stage = stage;
+        NOVA_PROFILE_SCOPE("Shader::Create");
+
+        auto shader = context->shader_pool.Acquire();
+        shader->context = context;
+        shader->stage = stage;
 
         std::optional<std::vector<u32>> _spirv;
         std::string actual_entry = "main";
@@ -75,8 +77,6 @@ namespace nova
 
         auto& spirv = *_spirv;
 
-        Shader shader{ impl };
-
         shader->id = context->GetUID();
         shader->entry = std::move(actual_entry);
 
@@ -107,7 +107,7 @@ namespace nova
 
         if (shader->context->shader_objects && !is_rt_stage) {
             // shader objects
-            vkh::Check(impl->context->vkCreateShadersEXT(context->device, 1, PtrTo(VkShaderCreateInfoEXT {
+            vkh::Check(shader->context->vkCreateShadersEXT(context->device, 1, PtrTo(VkShaderCreateInfoEXT {
                 .sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT,
                 .stage = VkShaderStageFlagBits(GetVulkanShaderStage(shader->stage)),
                 .nextStage = next_stages,
@@ -135,7 +135,7 @@ namespace nova
 
         } else {
             // shader modules
-            vkh::Check(impl->context->vkCreateShaderModule(context->device, PtrTo(VkShaderModuleCreateInfo {
+            vkh::Check(shader->context->vkCreateShaderModule(context->device, PtrTo(VkShaderModuleCreateInfo {
                 .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
                 .codeSize = spirv.size() * sizeof(u32),
                 .pCode = spirv.data(),
@@ -151,6 +151,8 @@ namespace nova
             return;
         }
 
+        ImplPool<Shader>::Validate(impl, generation);
+
         if (impl->handle) {
             impl->context->vkDestroyShaderModule(impl->context->device, impl->handle, impl->context->alloc);
         }
@@ -159,7 +161,7 @@ namespace nova
             impl->context->vkDestroyShaderEXT(impl->context->device, impl->shader, impl->context->alloc);
         }
 
-        delete impl;
+        impl->context->shader_pool.Release(impl, generation);
         impl = nullptr;
     }
 
@@ -380,7 +380,7 @@ namespace nova
                 vkh::Check(swapchain->context->vkBindImageMemory(swapchain->context->device, vkimage, memory, 0));
 
                 {
-                    auto& image = (swapchain->images[i] = { new Image::Impl });
+                    auto& image = (swapchain->images[i] = { swapchain->context->image_pool.Acquire() });
                     image->context = swapchain->context;
 
                     image->usage = swapchain->usage;
@@ -119,7 +119,7 @@ namespace nova
                     }
                     swapchain->images.resize(vk_images.size());
                     for (uint32_t i = 0; i < vk_images.size(); ++i) {
-                        auto& image = (swapchain->images[i] = { new Image::Impl });
+                        auto& image = (swapchain->images[i] = { queue->context->image_pool.Acquire() });
                         image->context = queue->context;
 
                         image->usage = swapchain->usage;
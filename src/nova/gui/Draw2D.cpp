@@ -1,6 +1,8 @@
 #include "Draw2D.hpp"
 #include "Draw2DRect.slang"
 
+#include <nova/core/ConcurrentHashMap.hpp>
+
 #define FT_CONFIG_OPTION_SUBPIXEL_RENDERING
 #include <ft2build.h>
 #include <freetype/freetype.h>
@@ -29,8 +31,11 @@ namespace nova::draw
         FT_Library ft;
         FT_Face  face;
 
+        ConcurrentHashMap<GlyphKey, Glyph> glyphs;
+
+        // FreeType faces are not thread safe, guards the face, sizes and scratch pixels while loading a glyph
+        std::mutex freetype_mutex;
         ankerl::unordered_dense::map<uint32_t, FT_Size> sizes;
-        ankerl::unordered_dense::map<GlyphKey, Glyph>  glyphs;
 
         struct Pixel { u8 r, g, b, a; };
         std::vector<Pixel> pixels;
@@ -60,9 +65,11 @@ namespace nova::draw
             FT_Done_Face(face);
             FT_Done_FreeType(ft);
 
-            for (auto&[key, glyph] : glyphs) {
-                glyph.image.Destroy();
-            }
+            glyphs.ForEach([](auto&, Glyph& glyph) {
+                if (!glyph.fallback) {
+                    glyph.image.Destroy();
+                }
+            });
         }
 
         const Glyph& GetGlyphForCodepoint(char32_t codepoint, uint32_t size)
@@ -73,12 +80,29 @@ namespace nova::draw
             key.code = codepoint;
             key.size = size;
 
-            auto& glyph = glyphs[key];
-            if (glyph.loaded) {
+            return glyphs.GetOrCreate(key, [&] {
+                Glyph glyph = LoadGlyph(codepoint, size);
+                if (glyph.loaded) {
+                    return glyph;
+                }
+
+                // TODO: Fallback fonts and/or unicode missing glyph
+                NOVA_ASSERT(codepoint != 0, "codepoint 0 failed to load!");
+                nova::Log("  char \"{}\" ({}) not found, falling back to codepoint 0", FromUtf32({&codepoint, 1}), uint32_t(codepoint));
+
+                // Missing codepoints share the codepoint 0 glyph of the same size, which is loaded only once
+                glyph = GetGlyphForCodepoint(0, size);
+                glyph.fallback = true;
                 return glyph;
-            }
+            });
+        }
 
-            glyph.loaded = true;
+        // Returns a glyph with loaded unset if the face has no glyph for the codepoint
+        Glyph LoadGlyph(char32_t codepoint, uint32_t size)
+        {
+            std::scoped_lock lock{ freetype_mutex };
+
+            Glyph glyph = {};
 
             auto& ft_size = sizes[size];
             if (!ft_size) {
@@ -95,11 +119,9 @@ namespace nova::draw
             FT_Set_Transform(face, nullptr, &vec);
 
             if (FT_Err_Ok != FT_Load_Char(face, FT_ULong(codepoint), FT_LOAD_RENDER)) {
-                // TODO: Fallback fonts and/or unicode missing glyph
-                NOVA_ASSERT(codepoint != 0, "codepoint 0 failed to load!");
-                nova::Log("  char \"{}\" ({}) not found, falling back to codepoint 0", FromUtf32({&codepoint, 1}), uint32_t(codepoint));
-                return GetGlyphForCodepoint(0, size);
+                return glyph;
             }
+            glyph.loaded = true;
 
             u32 w = face->glyph->bitmap.width;
             u32 h = face->glyph->bitmap.rows;
@@ -211,7 +233,7 @@ namespace nova::draw
 
     void Draw2D::DrawString(StringView str, Vec2 _pos, Font& font, f32 size)
     {
-        for (c32 c : ToUtf32(str)) {
+        for (c32 c : Utf8Codepoints(str)) {
             auto pos = glm::roundEven(_pos);
             auto& g = font.GetGlyphForCodepoint(c, u32(size));
 
@@ -236,7 +258,7 @@ namespace nova::draw
 
         Vec2 _pos = Vec2(0);
 
-        for (auto c : ToUtf32(str)) {
+        for (c32 c : Utf8Codepoints(str)) {
             auto pos = glm::roundEven(_pos);
             auto& g = font.GetGlyphForCodepoint(c, u32(size));
 
@@ -3,6 +3,7 @@
 #include "Draw2DShared.slang"
 
 #include <nova/gpu/RHI.hpp>
+#include <nova/core/VirtualVector.hpp>
 
 namespace nova::draw
 {
@@ -29,6 +30,9 @@ namespace nova::draw
         f32 advance;
         Vec2 offset;
         bool loaded = false;
+
+        // Stands in for a missing codepoint, the image is shared with and owned by the codepoint 0 glyph
+        bool fallback = false;
     };
 
 // -----------------------------------------------------------------------------
@@ -54,7 +58,7 @@ namespace nova::draw
 
         Bounds2F bounds;
 
-        std::vector<DrawCommand> draw_commands;
+        VirtualVector<DrawCommand> draw_commands;
         std::vector<Font*> loaded_fonts;
 
     public:
@@ -1,5 +1,8 @@
 #include "Image.hpp"
 
+#include <nova/core/Parallel.hpp>
+#include <nova/core/Profile.hpp>
+
 #include <rdo_bc_encoder.h>
 
 #pragma warning(push)
@@ -349,6 +352,8 @@ namespace nova
 
     void Image_Copy(const ImageAccessor& src, const void* src_data, const ImageAccessor& dst, void* dst_data)
     {
+        NOVA_PROFILE_SCOPE("Image_Copy");
+
         NOVA_ASSERT(src.desc.width == dst.desc.width
                 && src.desc.height == dst.desc.height
                 && src.desc.layers == dst.desc.layers
@@ -358,23 +363,21 @@ namespace nova
             for (u32 layer = 0; layer < src.desc.layers; ++layer) {
                 const auto& mip_accessor = src.accessors[mip];
                 if (mip_accessor.hblocks > mip_accessor.vblocks) {
-#pragma omp parallel for
-                    for (u32 x = 0; x < mip_accessor.hblocks; ++x) {
+                    ParallelFor(mip_accessor.hblocks, 1, [&](u64 x) {
                         for (u32 y = 0; y < mip_accessor.vblocks; ++y) {
                             Block block = {};
-                            src.Read(src_data, {x, y, layer, mip}, block);
-                            dst.Write(dst_data, {x, y, layer, mip}, block);
+                            src.Read(src_data, {u32(x), y, layer, mip}, block);
+                            dst.Write(dst_data, {u32(x), y, layer, mip}, block);
                         }
-                    }
+                    });
                 } else {
-#pragma omp parallel for
-                    for (u32 y = 0; y < mip_accessor.vblocks; ++y) {
+                    ParallelFor(mip_accessor.vblocks, 1, [&](u64 y) {
                         for (u32 x = 0; x < mip_accessor.hblocks; ++x) {
                             Block block = {};
-                            src.Read(src_data, {x, y, layer, mip}, block);
-                            dst.Write(dst_data, {x, y, layer, mip}, block);
+                            src.Read(src_data, {x, u32(y), layer, mip}, block);
+                            dst.Write(dst_data, {x, u32(y), layer, mip}, block);
                         }
-                    }
+                    });
                 }
             }
         }
@@ -247,7 +247,7 @@ namespace nova
 
 // -----------------------------------------------------------------------------
 
-    using AppCallback = std::function<void(const AppEvent&)>;
+    using AppCallback = Function<void(const AppEvent&)>;
 
     struct Application : Handle<Application>
     {
@@ -367,9 +367,11 @@ namespace nova
 
     Window Window::SetTitle(std::string _title) const
     {
+        NOVA_STACK_POINT();
+
         impl->title = std::move(_title);
 
-        ::SetWindowTextW(impl->handle, ToUtf16(impl->title).c_str());
+        ::SetWindowTextW(impl->handle, NOVA_STACK_TO_UTF16(impl->title).Data());
 
         return *this;
     }